@@ -0,0 +1,290 @@
+/**
+ * @file batch_mekf.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Implements {@link batch_mekf.h}.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "batch_mekf.h"
+#include "quaternion_stats.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    /**
+     * @brief Rotation matrix of a unit quaternion (c, x, y, z).
+     *
+     */
+    inline void rotation(double c, double x, double y, double z, double r[3][3])
+    {
+        r[0][0] = 1 - 2 * (y * y + z * z);
+        r[0][1] = 2 * (x * y - c * z);
+        r[0][2] = 2 * (x * z + c * y);
+        r[1][0] = 2 * (x * y + c * z);
+        r[1][1] = 1 - 2 * (x * x + z * z);
+        r[1][2] = 2 * (y * z - c * x);
+        r[2][0] = 2 * (x * z - c * y);
+        r[2][1] = 2 * (y * z + c * x);
+        r[2][2] = 1 - 2 * (x * x + y * y);
+    }
+
+    /**
+     * @brief Predicts the filters [0, n). The planes are restrict parameters so that the loop is vectorized.
+     *
+     */
+    template <ensiie::Accuracy A>
+    void predict(double* __restrict qt, double* __restrict qu, double* __restrict qv, double* __restrict qw,
+                 double* __restrict pxx, double* __restrict pxy, double* __restrict pxz, double* __restrict pyy,
+                 double* __restrict pyz, double* __restrict pzz, const double* __restrict gyro, double dt,
+                 double noise, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            // Increment d = exp(w dt / 2).
+            double x = gyro[3 * i] * dt, y = gyro[3 * i + 1] * dt, z = gyro[3 * i + 2] * dt;
+            double angle = std::sqrt(x * x + y * y + z * z);
+            double s, c;
+            if constexpr (A == ensiie::Accuracy::Exact)
+            {
+                ensiie::math::sincos<A>(angle / 2, s, c);
+            }
+            else
+            {
+                // predict() checked the domain for the whole batch.
+                ensiie::math::sincosUnchecked<A>(angle / 2, s, c);
+            }
+            // sin(angle / 2) / angle. The offset, negligible beside any angle which matters, avoids a division by 0
+            // without a selection, which would stop the vectorization.
+            double k = s / (angle + 1e-300);
+            x *= k;
+            y *= k;
+            z *= k;
+
+            // q = q * d, renormalized against the drift.
+            double t = qt[i] * c - qu[i] * x - qv[i] * y - qw[i] * z;
+            double u = qt[i] * x + qu[i] * c + qv[i] * z - qw[i] * y;
+            double v = qt[i] * y - qu[i] * z + qv[i] * c + qw[i] * x;
+            double w = qt[i] * z + qu[i] * y - qv[i] * x + qw[i] * c;
+            double inv = 1 / std::sqrt(t * t + u * u + v * v + w * w);
+            qt[i] = t * inv;
+            qu[i] = u * inv;
+            qv[i] = v * inv;
+            qw[i] = w * inv;
+
+            // The error angle is rotated by the transpose F of the rotation of d: P = F P F^T + noise dt I.
+            double r[3][3];
+            rotation(c, x, y, z, r);
+            double p[3][3] = {{pxx[i], pxy[i], pxz[i]}, {pxy[i], pyy[i], pyz[i]}, {pxz[i], pyz[i], pzz[i]}};
+            double m[3][3];
+            for (int a = 0; a < 3; a++)
+            {
+                for (int b = 0; b < 3; b++)
+                {
+                    m[a][b] = r[0][a] * p[0][b] + r[1][a] * p[1][b] + r[2][a] * p[2][b];
+                }
+            }
+            double q = noise * dt;
+            pxx[i] = m[0][0] * r[0][0] + m[0][1] * r[1][0] + m[0][2] * r[2][0] + q;
+            pxy[i] = m[0][0] * r[0][1] + m[0][1] * r[1][1] + m[0][2] * r[2][1];
+            pxz[i] = m[0][0] * r[0][2] + m[0][1] * r[1][2] + m[0][2] * r[2][2];
+            pyy[i] = m[1][0] * r[0][1] + m[1][1] * r[1][1] + m[1][2] * r[2][1] + q;
+            pyz[i] = m[1][0] * r[0][2] + m[1][1] * r[1][2] + m[1][2] * r[2][2];
+            pzz[i] = m[2][0] * r[0][2] + m[2][1] * r[1][2] + m[2][2] * r[2][2] + q;
+        }
+    }
+
+    /**
+     * @brief Updates the filters [0, n). The planes are restrict parameters so that the loop is vectorized.
+     *
+     */
+    void update(double* __restrict qt, double* __restrict qu, double* __restrict qv, double* __restrict qw,
+                double* __restrict pxx, double* __restrict pxy, double* __restrict pxz, double* __restrict pyy,
+                double* __restrict pyz, double* __restrict pzz, const double* __restrict measurements,
+                const double ref[3], double variance, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            double mx = measurements[3 * i], my = measurements[3 * i + 1], mz = measurements[3 * i + 2];
+            double norm2 = mx * mx + my * my + mz * mz;
+            // Null measurements get a null gain, through a factor rather than a branch so that the loop is vectorized.
+            double gain = norm2 > 1e-300 ? 1 : 0;
+            double inv = 1 / std::sqrt(norm2 + 1e-300);
+            mx *= inv;
+            my *= inv;
+            mz *= inv;
+
+            // Predicted measurement h = R(q)^T ref, whose Jacobian with respect to the error angle is H = [h x].
+            double t = qt[i], u = qu[i], v = qv[i], w = qw[i];
+            double r[3][3];
+            rotation(t, u, v, w, r);
+            double hx = r[0][0] * ref[0] + r[1][0] * ref[1] + r[2][0] * ref[2];
+            double hy = r[0][1] * ref[0] + r[1][1] * ref[1] + r[2][1] * ref[2];
+            double hz = r[0][2] * ref[0] + r[1][2] * ref[1] + r[2][2] * ref[2];
+            double h[3][3] = {{0, -hz, hy}, {hz, 0, -hx}, {-hy, hx, 0}};
+
+            // M = P H^T and S = H M + variance I.
+            double p[3][3] = {{pxx[i], pxy[i], pxz[i]}, {pxy[i], pyy[i], pyz[i]}, {pxz[i], pyz[i], pzz[i]}};
+            double m[3][3];
+            for (int a = 0; a < 3; a++)
+            {
+                for (int b = 0; b < 3; b++)
+                {
+                    m[a][b] = p[a][0] * h[b][0] + p[a][1] * h[b][1] + p[a][2] * h[b][2];
+                }
+            }
+            double sxx = h[0][0] * m[0][0] + h[0][1] * m[1][0] + h[0][2] * m[2][0] + variance;
+            double sxy = h[0][0] * m[0][1] + h[0][1] * m[1][1] + h[0][2] * m[2][1];
+            double sxz = h[0][0] * m[0][2] + h[0][1] * m[1][2] + h[0][2] * m[2][2];
+            double syy = h[1][0] * m[0][1] + h[1][1] * m[1][1] + h[1][2] * m[2][1] + variance;
+            double syz = h[1][0] * m[0][2] + h[1][1] * m[1][2] + h[1][2] * m[2][2];
+            double szz = h[2][0] * m[0][2] + h[2][1] * m[1][2] + h[2][2] * m[2][2] + variance;
+
+            // S^-1 from the cofactors, S being symmetric positive definite.
+            double cxx = syy * szz - syz * syz, cxy = sxz * syz - sxy * szz, cxz = sxy * syz - sxz * syy;
+            double cyy = sxx * szz - sxz * sxz, cyz = sxy * sxz - sxx * syz, czz = sxx * syy - sxy * sxy;
+            double id = 1 / (sxx * cxx + sxy * cxy + sxz * cxz);
+            double s[3][3] = {{cxx * id, cxy * id, cxz * id}, {cxy * id, cyy * id, cyz * id}, {cxz * id, cyz * id, czz * id}};
+
+            // K = M S^-1, e = K (m - h), P = P - K M^T.
+            double k[3][3];
+            for (int a = 0; a < 3; a++)
+            {
+                for (int b = 0; b < 3; b++)
+                {
+                    k[a][b] = m[a][0] * s[0][b] + m[a][1] * s[1][b] + m[a][2] * s[2][b];
+                }
+            }
+            double dx = mx - hx, dy = my - hy, dz = mz - hz;
+            // Half of the correction e.
+            double ex = gain * (k[0][0] * dx + k[0][1] * dy + k[0][2] * dz) / 2;
+            double ey = gain * (k[1][0] * dx + k[1][1] * dy + k[1][2] * dz) / 2;
+            double ez = gain * (k[2][0] * dx + k[2][1] * dy + k[2][2] * dz) / 2;
+
+            // q = q * (1, e / 2), renormalized.
+            double nt = t - u * ex - v * ey - w * ez;
+            double nu = u + t * ex + v * ez - w * ey;
+            double nv = v + t * ey - u * ez + w * ex;
+            double nw = w + t * ez + u * ey - v * ex;
+            double ninv = 1 / std::sqrt(nt * nt + nu * nu + nv * nv + nw * nw);
+            qt[i] = nt * ninv;
+            qu[i] = nu * ninv;
+            qv[i] = nv * ninv;
+            qw[i] = nw * ninv;
+            pxx[i] = p[0][0] - gain * (k[0][0] * m[0][0] + k[0][1] * m[0][1] + k[0][2] * m[0][2]);
+            pxy[i] = p[0][1] - gain * (k[0][0] * m[1][0] + k[0][1] * m[1][1] + k[0][2] * m[1][2]);
+            pxz[i] = p[0][2] - gain * (k[0][0] * m[2][0] + k[0][1] * m[2][1] + k[0][2] * m[2][2]);
+            pyy[i] = p[1][1] - gain * (k[1][0] * m[1][0] + k[1][1] * m[1][1] + k[1][2] * m[1][2]);
+            pyz[i] = p[1][2] - gain * (k[1][0] * m[2][0] + k[1][1] * m[2][1] + k[1][2] * m[2][2]);
+            pzz[i] = p[2][2] - gain * (k[2][0] * m[2][0] + k[2][1] * m[2][1] + k[2][2] * m[2][2]);
+        }
+    }
+}
+
+ensiie::BatchMekf::BatchMekf(std::size_t n, double variance) : n(n)
+{
+    if (!(variance > 0))
+    {
+        throw std::invalid_argument("The variance must be positive");
+    }
+    attitude[0].assign(n, 1);
+    for (int k = 1; k < 4; k++)
+    {
+        attitude[k].assign(n, 0);
+    }
+    for (int k = 0; k < 6; k++)
+    {
+        // xx, yy and zz are the planes 0, 3 and 5.
+        covariance[k].assign(n, k == 0 || k == 3 || k == 5 ? variance : 0);
+    }
+}
+
+void ensiie::BatchMekf::reset(std::size_t i, const Quaternion& q, double variance)
+{
+    if (!(variance > 0))
+    {
+        throw std::invalid_argument("The variance must be positive");
+    }
+    Quaternion unit = q.normalize();
+    attitude[0][i] = unit.getT();
+    attitude[1][i] = unit.getU();
+    attitude[2][i] = unit.getV();
+    attitude[3][i] = unit.getW();
+    for (int k = 0; k < 6; k++)
+    {
+        covariance[k][i] = k == 0 || k == 3 || k == 5 ? variance : 0;
+    }
+}
+
+ensiie::Quaternion ensiie::BatchMekf::getAttitude(std::size_t i) const
+{
+    return Quaternion(attitude[0][i], attitude[1][i], attitude[2][i], attitude[3][i]);
+}
+
+void ensiie::BatchMekf::getCovariance(std::size_t i, double p[3][3]) const
+{
+    p[0][0] = covariance[0][i];
+    p[0][1] = p[1][0] = covariance[1][i];
+    p[0][2] = p[2][0] = covariance[2][i];
+    p[1][1] = covariance[3][i];
+    p[1][2] = p[2][1] = covariance[4][i];
+    p[2][2] = covariance[5][i];
+}
+
+void ensiie::BatchMekf::predict(const double* gyro, double dt, double noise, Accuracy accuracy)
+{
+    if (!(dt >= 0) || !(noise >= 0))
+    {
+        throw std::invalid_argument("The time step and the noise must be non-negative");
+    }
+    QUATERNION_KERNEL(Mekf, n);
+    double* c[6] = {covariance[0].data(), covariance[1].data(), covariance[2].data(),
+                    covariance[3].data(), covariance[4].data(), covariance[5].data()};
+    double* q[4] = {attitude[0].data(), attitude[1].data(), attitude[2].data(), attitude[3].data()};
+    if (accuracy != Accuracy::Exact)
+    {
+        // The approximations are used without a check per filter, so the largest half angle must be in their domain.
+        double largest = 0;
+        for (std::size_t i = 0; i < 3 * n; i++)
+        {
+            largest = std::max(largest, std::abs(gyro[i]));
+        }
+        // The norm of the rate is at most sqrt(3) times its largest coordinate.
+        if (!(largest * 1.7320508075688772 * dt / 2 < math::SINCOS_DOMAIN))
+        {
+            accuracy = Accuracy::Exact;
+        }
+    }
+    switch (accuracy)
+    {
+    case Accuracy::Ulp:
+        return ::predict<Accuracy::Ulp>(q[0], q[1], q[2], q[3], c[0], c[1], c[2], c[3], c[4], c[5], gyro, dt, noise, n);
+    case Accuracy::Fast:
+        return ::predict<Accuracy::Fast>(q[0], q[1], q[2], q[3], c[0], c[1], c[2], c[3], c[4], c[5], gyro, dt, noise, n);
+    default:
+        return ::predict<Accuracy::Exact>(q[0], q[1], q[2], q[3], c[0], c[1], c[2], c[3], c[4], c[5], gyro, dt, noise, n);
+    }
+}
+
+void ensiie::BatchMekf::update(const double* measurements, const double reference[3], double variance)
+{
+    if (!(variance > 0))
+    {
+        throw std::invalid_argument("The variance must be positive");
+    }
+    double norm = std::sqrt(reference[0] * reference[0] + reference[1] * reference[1] + reference[2] * reference[2]);
+    if (!(norm > 0))
+    {
+        throw std::invalid_argument("Null reference direction");
+    }
+    QUATERNION_KERNEL(Mekf, n);
+    const double ref[3] = {reference[0] / norm, reference[1] / norm, reference[2] / norm};
+    ::update(attitude[0].data(), attitude[1].data(), attitude[2].data(), attitude[3].data(), covariance[0].data(),
+             covariance[1].data(), covariance[2].data(), covariance[3].data(), covariance[4].data(),
+             covariance[5].data(), measurements, ref, variance, n);
+}
@@ -0,0 +1,115 @@
+/**
+ * @file batch_mekf.h
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Provides a bank of multiplicative extended Kalman filters of attitude, run as batch kernels.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef BATCH_MEKF_H
+#define BATCH_MEKF_H
+
+#include "quaternion.h"
+#include "quaternion_math.h"
+#include <cstddef>
+#include <vector>
+
+namespace ensiie
+{
+    /**
+     * @brief Multiplicative extended Kalman filters (MEKF) estimating the attitudes of many sensors at once.
+     *
+     * Each filter estimates the orientation q of a sensor (body to world), with the covariance P of the error
+     * angle e such that the true orientation is q * exp(e / 2). The gyroscope rates drive the prediction and the
+     * measurements of a known world direction in the body frame (for instance gravity from an accelerometer)
+     * drive the update.
+     *
+     * The states are stored as planes across the filters (all t, all u... then the 6 coefficients xx, xy, xz, yy,
+     * yz, zz of P), and predict() and update() run one branch-free loop over all the filters, which the compiler
+     * vectorizes with the Ulp and Fast accuracies. Nothing is allocated after the construction. A bank is used by
+     * one thread at a time: to use several cores, split the sensors between banks.
+     */
+    class BatchMekf
+    {
+    private:
+        std::size_t n;
+        std::vector<double> attitude[4];
+        std::vector<double> covariance[6];
+
+    public:
+        /**
+         * @brief Construct a bank of filters at the identity.
+         * @throws std::invalid_argument If variance is not positive.
+         * @param n Number of filters.
+         * @param variance Initial variance of each axis of the error angle, in rad^2.
+         */
+        explicit BatchMekf(std::size_t n, double variance = 1);
+
+        /**
+         * @brief Get the number of filters.
+         *
+         * @return std::size_t Number of filters.
+         */
+        std::size_t size() const { return n; };
+
+        /**
+         * @brief Restarts a filter.
+         * @throws std::invalid_argument If q is null or variance is not positive.
+         * @param i Filter.
+         * @param q Orientation, normalized.
+         * @param variance Variance of each axis of the error angle, in rad^2.
+         */
+        void reset(std::size_t i, const Quaternion& q, double variance);
+
+        /**
+         * @brief Gets the orientation estimated by a filter.
+         *
+         * @param i Filter.
+         * @return Quaternion Unit orientation, body to world.
+         */
+        Quaternion getAttitude(std::size_t i) const;
+
+        /**
+         * @brief Gets the covariance of the error angle of a filter.
+         *
+         * @param i Filter.
+         * @param p Covariance, in rad^2.
+         */
+        void getCovariance(std::size_t i, double p[3][3]) const;
+
+        /**
+         * @brief Gets a plane of the orientations.
+         *
+         * @param k 0 for t, 1 for u, 2 for v, 3 for w.
+         * @return const double* Components of the filters.
+         */
+        const double* plane(int k) const { return attitude[k].data(); };
+
+        /**
+         * @brief Propagates all the filters by the gyroscope rates.
+         * @throws std::invalid_argument If dt or noise is negative.
+         * @param gyro Angular velocities in the body frame x, y, z of each filter (3 * size() doubles), in rad/s.
+         * @param dt Time step, in s.
+         * @param noise Variance density of the gyroscope noise, in rad^2/s.
+         * @param accuracy Accuracy of the trigonometric functions.
+         */
+        void predict(const double* gyro, double dt, double noise, Accuracy accuracy = Accuracy::Exact);
+
+        /**
+         * @brief Corrects all the filters by a measured direction.
+         *
+         * A filter whose measurement is null is left unchanged, so that sensors without a sample can be skipped.
+         * @throws std::invalid_argument If reference is null or variance is not positive.
+         * @param measurements Directions measured in the body frame x, y, z of each filter (3 * size() doubles),
+         * normalized by the filter.
+         * @param reference Direction in the world frame, normalized by the filter.
+         * @param variance Variance of each axis of the normalized measurements.
+         */
+        void update(const double* measurements, const double reference[3], double variance);
+    };
+}
+
+#endif // BATCH_MEKF_H
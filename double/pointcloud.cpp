@@ -0,0 +1,333 @@
+/**
+ * @file pointcloud.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Implements {@link pointcloud.h}.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "pointcloud.h"
+#include "quaternion_stats.h"
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    [[noreturn]] void fail(const std::string& what, const std::string& path)
+    {
+        throw std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+    }
+
+    /**
+     * @brief A file descriptor, closed on destruction.
+     *
+     */
+    class File
+    {
+    private:
+        int fd;
+
+    public:
+        File(const std::string& path, int flags) : fd(::open(path.c_str(), flags, 0644))
+        {
+            if (fd < 0)
+            {
+                fail("Cannot open", path);
+            }
+        }
+        ~File() { ::close(fd); }
+        File(const File&) = delete;
+        File& operator=(const File&) = delete;
+        int get() const { return fd; }
+    };
+
+    /**
+     * @brief A shared mapping of a whole file, unmapped on destruction.
+     *
+     */
+    class Mapping
+    {
+    private:
+        void* address;
+        std::size_t size;
+
+    public:
+        Mapping(const File& file, std::size_t size, bool writable, const std::string& path) : size(size)
+        {
+            address = ::mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file.get(), 0);
+            if (address == MAP_FAILED)
+            {
+                fail("Cannot map", path);
+            }
+            ::madvise(address, size, MADV_SEQUENTIAL);
+        }
+        ~Mapping() { ::munmap(address, size); }
+
+        /**
+         * @brief Writes the modified pages to the file, waiting for the writes to complete.
+         * @throws std::runtime_error If the pages cannot be written.
+         */
+        void flush(const std::string& path) const
+        {
+            if (::msync(address, size, MS_SYNC) != 0)
+            {
+                fail("Cannot flush", path);
+            }
+        }
+        Mapping(const Mapping&) = delete;
+        Mapping& operator=(const Mapping&) = delete;
+        char* get() const { return static_cast<char*>(address); }
+    };
+
+    template <typename T>
+    void rotateRange(const T* in, T* out, std::size_t n, const double m[9])
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            double x = in[3 * i], y = in[3 * i + 1], z = in[3 * i + 2];
+            out[3 * i] = static_cast<T>(m[0] * x + m[1] * y + m[2] * z);
+            out[3 * i + 1] = static_cast<T>(m[3] * x + m[4] * y + m[5] * z);
+            out[3 * i + 2] = static_cast<T>(m[6] * x + m[7] * y + m[8] * z);
+        }
+    }
+
+    /**
+     * @brief Rotation matrices of the rotations, row-major, 9 doubles per rotation.
+     * @throws std::invalid_argument If the norm of a rotation is not finite or at most 1e-15, the threshold of
+     * Quaternion::normalize().
+     */
+    std::vector<double> matrices(const ensiie::Quaternion* rotations, std::size_t groups)
+    {
+        std::vector<double> m(9 * groups);
+        for (std::size_t g = 0; g < groups; g++)
+        {
+            const ensiie::Quaternion& q = rotations[g];
+            double n = q.norm();
+            if (!(n > 1e-15) || !std::isfinite(n))
+            {
+                throw std::invalid_argument("Rotation " + std::to_string(g) + " is null or not finite");
+            }
+            ensiie::Quaternion(q.getT() / n, q.getU() / n, q.getV() / n, q.getW() / n).toMatrix(&m[9 * g]);
+        }
+        return m;
+    }
+
+    /**
+     * @brief Whether output names an existing file that is also input, through any path or link.
+     *
+     */
+    bool sameFile(const struct stat& in, const std::string& output)
+    {
+        if (output.empty())
+        {
+            return true;
+        }
+        struct stat out;
+        if (::stat(output.c_str(), &out) != 0)
+        {
+            if (errno == ENOENT)
+            {
+                return false;
+            }
+            fail("Cannot stat", output);
+        }
+        return out.st_dev == in.st_dev && out.st_ino == in.st_ino;
+    }
+
+    /**
+     * @brief Rotates the points [first, last) of a tile, group by group.
+     *
+     */
+    template <typename T>
+    void rotateTile(const char* in, char* out, std::size_t first, std::size_t last, const double* matrices,
+                    std::size_t groupSize)
+    {
+        const T* src = reinterpret_cast<const T*>(in);
+        T* dst = reinterpret_cast<T*>(out);
+        for (std::size_t p = first; p < last;)
+        {
+            std::size_t g = p / groupSize;
+            std::size_t end = groupSize - p % groupSize < last - p ? p + (groupSize - p % groupSize) : last;
+            rotateRange(src + 3 * p, dst + 3 * p, end - p, &matrices[9 * g]);
+            p = end;
+        }
+    }
+
+    std::size_t transform(const std::string& input, const std::string& output, const ensiie::PointCloudOptions& options,
+                          const ensiie::Quaternion* rotations, std::size_t groups, std::size_t groupSize)
+    {
+        // Every rotation is checked before the output is created or truncated.
+        std::vector<double> m = matrices(rotations, groups);
+        struct stat st;
+        if (::stat(input.c_str(), &st) != 0)
+        {
+            fail("Cannot stat", input);
+        }
+        // Opening the input itself as the output would truncate it.
+        bool inPlace = sameFile(st, output);
+        File in(input, inPlace ? O_RDWR : O_RDONLY);
+        if (::fstat(in.get(), &st) != 0)
+        {
+            fail("Cannot stat", input);
+        }
+        std::size_t size = static_cast<std::size_t>(st.st_size);
+        std::size_t pointBytes = options.format == ensiie::PointFormat::Float32 ? 3 * sizeof(float) : 3 * sizeof(double);
+        if (size % pointBytes != 0)
+        {
+            throw std::invalid_argument("The size of " + input + " is not a whole number of points");
+        }
+        std::size_t points = size / pointBytes;
+        if (groupSize != std::numeric_limits<std::size_t>::max() && (groupSize == 0 || points / groupSize != groups || points % groupSize != 0))
+        {
+            throw std::invalid_argument("The number of points of " + input + " is not groups * groupSize");
+        }
+        QUATERNION_KERNEL(PointCloud, points);
+
+        std::unique_ptr<File> out;
+        if (!inPlace)
+        {
+            out = std::make_unique<File>(output, O_RDWR | O_CREAT | O_TRUNC);
+            if (::ftruncate(out->get(), static_cast<off_t>(size)) != 0)
+            {
+                fail("Cannot resize", output);
+            }
+        }
+        if (size == 0)
+        {
+            return 0;
+        }
+        Mapping src(in, size, inPlace, input);
+        std::unique_ptr<Mapping> dst;
+        if (!inPlace)
+        {
+            dst = std::make_unique<Mapping>(*out, size, true, output);
+        }
+        char* target = inPlace ? src.get() : dst->get();
+
+        // A tile is a whole number of pages and of points, so that hints apply to whole tiles.
+        std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        std::size_t unit = page / std::gcd(page, pointBytes) * pointBytes;
+        std::size_t tile = std::max<std::size_t>(1, options.tileBytes / unit) * unit;
+        std::size_t tiles = (size + tile - 1) / tile;
+        unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+        threads = static_cast<unsigned>(std::min<std::size_t>(threads, tiles));
+
+        std::atomic<std::size_t> next(0);
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        auto worker = [&] {
+            try
+            {
+                for (std::size_t k = next++; k < tiles; k = next++)
+                {
+                    // Tiles are taken in order: this worker's next tile is about threads tiles ahead.
+                    std::size_t ahead = (k + threads) * tile;
+                    if (ahead < size)
+                    {
+                        ::madvise(src.get() + ahead, std::min(tile, size - ahead), MADV_WILLNEED);
+                    }
+                    std::size_t begin = k * tile;
+                    std::size_t length = std::min(tile, size - begin);
+                    std::size_t first = begin / pointBytes;
+                    std::size_t last = (begin + length) / pointBytes;
+                    if (options.format == ensiie::PointFormat::Float32)
+                    {
+                        rotateTile<float>(src.get(), target, first, last, m.data(), groupSize);
+                    }
+                    else
+                    {
+                        rotateTile<double>(src.get(), target, first, last, m.data(), groupSize);
+                    }
+                    if (!inPlace)
+                    {
+                        // The input tile will not be read again: release its pages.
+                        ::madvise(src.get() + begin, length, MADV_DONTNEED);
+                    }
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                error = std::current_exception();
+                next = tiles;
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned i = 1; i < threads; i++)
+        {
+            pool.emplace_back([&] {
+                // The operations of the workers are internal to the kernel.
+                QUATERNION_UNCOUNTED();
+                worker();
+            });
+        }
+        worker();
+        for (std::thread& t : pool)
+        {
+            t.join();
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+        // The points are in the file, not only in the page cache, when the function returns.
+        if (inPlace)
+        {
+            src.flush(input);
+        }
+        else
+        {
+            dst->flush(output);
+        }
+        return points;
+    }
+}
+
+std::size_t ensiie::rotatePointCloud(const std::string& input, const std::string& output, const Quaternion& q,
+                                     const PointCloudOptions& options)
+{
+    return transform(input, output, options, &q, 1, std::numeric_limits<std::size_t>::max());
+}
+
+std::size_t ensiie::rotatePointGroups(const std::string& input, const std::string& output, const Quaternion* rotations,
+                                      std::size_t groups, std::size_t groupSize, const PointCloudOptions& options)
+{
+    return transform(input, output, options, rotations, groups, groupSize);
+}
+
+#else
+
+std::size_t ensiie::rotatePointCloud(const std::string&, const std::string&, const Quaternion&, const PointCloudOptions&)
+{
+    throw std::runtime_error("Memory-mapped point clouds are not supported on Windows");
+}
+
+std::size_t ensiie::rotatePointGroups(const std::string&, const std::string&, const Quaternion*, std::size_t, std::size_t,
+                                      const PointCloudOptions&)
+{
+    throw std::runtime_error("Memory-mapped point clouds are not supported on Windows");
+}
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * @file pointcloud.h
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Provides out-of-core rotation of point clouds stored in files.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * A point cloud file is a raw array of points, each stored as x, y, z in native floats or doubles.
+ * Files are memory-mapped and processed in page-aligned tiles by worker threads, with hints to the
+ * kernel to read ahead and to drop the tiles already processed, so that clouds larger than the memory
+ * are streamed from and to the disk. The output is flushed to the file (msync) before the functions return.
+ * Only available on POSIX systems.
+ *
+ */
+
+#ifndef POINTCLOUD_H
+#define POINTCLOUD_H
+
+#include "quaternion.h"
+#include <cstddef>
+#include <string>
+
+namespace ensiie
+{
+    /**
+     * @brief Storage of the coordinates of a point.
+     *
+     */
+    enum class PointFormat
+    {
+        /**
+         * @brief 3 floats, 12 bytes per point.
+         *
+         */
+        Float32,
+        /**
+         * @brief 3 doubles, 24 bytes per point.
+         *
+         */
+        Float64
+    };
+
+    /**
+     * @brief Options of the point cloud functions.
+     *
+     */
+    struct PointCloudOptions
+    {
+        /**
+         * @brief Storage of the points.
+         *
+         */
+        PointFormat format = PointFormat::Float32;
+        /**
+         * @brief Number of worker threads, 0 for the number of cores.
+         *
+         */
+        unsigned threads = 0;
+        /**
+         * @brief Approximate size of a tile in bytes, rounded to a whole number of pages and points.
+         *
+         */
+        std::size_t tileBytes = std::size_t(1) << 20;
+    };
+
+    /**
+     * @brief Rotates every point of a point cloud file.
+     * @throws std::runtime_error If a file cannot be opened, mapped, resized or flushed.
+     * @throws std::invalid_argument If the file size is not a whole number of points, or q is null (norm at most
+     * 1e-15) or not finite.
+     * @param input Input file.
+     * @param output Output file, created or replaced. Empty or the same file as input, through any path, to rotate
+     * in place.
+     * @param q Rotation, normalized before use.
+     * @param options Options.
+     * @return std::size_t Number of points.
+     */
+    std::size_t rotatePointCloud(const std::string& input, const std::string& output, const Quaternion& q,
+                                 const PointCloudOptions& options = PointCloudOptions());
+
+    /**
+     * @brief Rotates consecutive groups of points of a point cloud file, each by its own rotation.
+     * @throws std::runtime_error If a file cannot be opened, mapped, resized or flushed.
+     * @throws std::invalid_argument If the file does not hold groups * groupSize points, or a rotation is null (norm
+     * at most 1e-15) or not finite. The rotations are checked before any file is opened, and the message gives the
+     * index of the first invalid one.
+     * @param input Input file.
+     * @param output Output file, created or replaced. Empty or the same file as input, through any path, to rotate
+     * in place.
+     * @param rotations Rotations, one per group, normalized before use.
+     * @param groups Number of groups.
+     * @param groupSize Number of points per group.
+     * @param options Options.
+     * @return std::size_t Number of points.
+     */
+    std::size_t rotatePointGroups(const std::string& input, const std::string& output, const Quaternion* rotations,
+                                  std::size_t groups, std::size_t groupSize,
+                                  const PointCloudOptions& options = PointCloudOptions());
+}
+
+#endif // POINTCLOUD_H
@@ -10,7 +10,9 @@
  */
 
 #include "quaternion.h"
+#include "quaternion_stats.h"
 #include <exception>
+#include <stdexcept>
 
 ensiie::Quaternion::Quaternion() : t(0), u(0), v(0), w(0)
 {
@@ -39,11 +41,129 @@ double ensiie::Quaternion::norm() const
 
 ensiie::Quaternion ensiie::Quaternion::inverse() const
 {
+    QUATERNION_COUNT(Inverse);
+    QUATERNION_UNCOUNTED();
     return conjugate() / std::pow(norm(), 2);
 }
 
+ensiie::Quaternion ensiie::Quaternion::normalize() const
+{
+    QUATERNION_COUNT(Normalize);
+    QUATERNION_UNCOUNTED();
+    return *this / norm();
+}
+
+ensiie::Quaternion ensiie::Quaternion::fromAxisAngle(double x, double y, double z, double angle, Accuracy accuracy)
+{
+    double n = std::sqrt(x * x + y * y + z * z);
+    if (n <= 1e-15)
+    {
+        QUATERNION_FAULT(NullRotationAxis);
+        throw std::invalid_argument("Null rotation axis");
+    }
+    double s, c;
+    math::sincos(angle / 2, s, c, accuracy);
+    s /= n;
+    return Quaternion(c, x * s, y * s, z * s);
+}
+
+ensiie::Quaternion ensiie::Quaternion::fromMatrix(const double m[9])
+{
+    // Shepperd's method: take the square root of the largest diagonal term to stay away from 0.
+    double trace = m[0] + m[4] + m[8];
+    Quaternion q;
+    if (trace > 0)
+    {
+        double s = 2 * std::sqrt(trace + 1);
+        q = Quaternion(s / 4, (m[7] - m[5]) / s, (m[2] - m[6]) / s, (m[3] - m[1]) / s);
+    }
+    else if (m[0] > m[4] && m[0] > m[8])
+    {
+        double s = 2 * std::sqrt(1 + m[0] - m[4] - m[8]);
+        q = Quaternion((m[7] - m[5]) / s, s / 4, (m[1] + m[3]) / s, (m[2] + m[6]) / s);
+    }
+    else if (m[4] > m[8])
+    {
+        double s = 2 * std::sqrt(1 + m[4] - m[0] - m[8]);
+        q = Quaternion((m[2] - m[6]) / s, (m[1] + m[3]) / s, s / 4, (m[5] + m[7]) / s);
+    }
+    else
+    {
+        double s = 2 * std::sqrt(1 + m[8] - m[0] - m[4]);
+        q = Quaternion((m[3] - m[1]) / s, (m[2] + m[6]) / s, (m[5] + m[7]) / s, s / 4);
+    }
+    return q.t < 0 ? -q : q;
+}
+
+void ensiie::Quaternion::toMatrix(double m[9]) const
+{
+    m[0] = 1 - 2 * (v * v + w * w);
+    m[1] = 2 * (u * v - t * w);
+    m[2] = 2 * (u * w + t * v);
+    m[3] = 2 * (u * v + t * w);
+    m[4] = 1 - 2 * (u * u + w * w);
+    m[5] = 2 * (v * w - t * u);
+    m[6] = 2 * (u * w - t * v);
+    m[7] = 2 * (v * w + t * u);
+    m[8] = 1 - 2 * (u * u + v * v);
+}
+
+void ensiie::Quaternion::rotate(double& x, double& y, double& z) const
+{
+    // p' = p + 2 r x (r x p + t p), with r the vector part.
+    double cx = v * z - w * y + t * x;
+    double cy = w * x - u * z + t * y;
+    double cz = u * y - v * x + t * z;
+    x += 2 * (v * cz - w * cy);
+    y += 2 * (w * cx - u * cz);
+    z += 2 * (u * cy - v * cx);
+}
+
+ensiie::Quaternion ensiie::Quaternion::slerp(const Quaternion& q1, const Quaternion& q2, double s, Accuracy accuracy)
+{
+    QUATERNION_COUNT(Slerp);
+    QUATERNION_UNCOUNTED();
+    Quaternion end = dot(q1, q2) < 0 ? -q2 : q2;
+    // Angle between q1 and end from the chords |q1 - end| and |q1 + end|: unlike acos(dot), it stays accurate
+    // when the quaternions are nearly parallel.
+    double dt = q1.t - end.t, du = q1.u - end.u, dv = q1.v - end.v, dw = q1.w - end.w;
+    double st = q1.t + end.t, su = q1.u + end.u, sv = q1.v + end.v, sw = q1.w + end.w;
+    double theta = 2 * math::atan2(std::sqrt(dt * dt + du * du + dv * dv + dw * dw),
+                                   std::sqrt(st * st + su * su + sv * sv + sw * sw), accuracy);
+    // sin(x theta) / sin(theta) = x sinc(x theta) / sinc(theta), defined down to theta = 0.
+    double k = 1 / math::sinc(theta, accuracy);
+    return q1 * ((1 - s) * math::sinc((1 - s) * theta, accuracy) * k) + end * (s * math::sinc(s * theta, accuracy) * k);
+}
+
+ensiie::Quaternion ensiie::Quaternion::exp(Accuracy accuracy) const
+{
+    QUATERNION_COUNT(Exp);
+    double n = std::sqrt(u * u + v * v + w * w);
+    double s, c;
+    math::sincos(n, s, c, accuracy);
+    // sin(n) / n tends to 1 at 0.
+    double k = n <= 1e-15 ? 1 : s / n;
+    double e = std::exp(t);
+    return Quaternion(e * c, e * k * u, e * k * v, e * k * w);
+}
+
+ensiie::Quaternion ensiie::Quaternion::log(Accuracy accuracy) const
+{
+    QUATERNION_COUNT(Log);
+    double q = norm();
+    if (q <= 1e-15)
+    {
+        QUATERNION_FAULT(LogarithmOfZero);
+        throw std::invalid_argument("Logarithm of zero");
+    }
+    double n = std::sqrt(u * u + v * v + w * w);
+    double k = n == 0 ? 0 : math::atan2(n, t, accuracy) / n;
+    return Quaternion(std::log(q), k * u, k * v, k * w);
+}
+
 ensiie::Quaternion& ensiie::Quaternion::operator+=(const Quaternion& q)
 {
+    QUATERNION_COUNT(Add);
     t += q.t;
     u += q.u;
     v += q.v;
@@ -53,6 +173,7 @@ ensiie::Quaternion& ensiie::Quaternion::operator+=(const Quaternion& q)
 
 ensiie::Quaternion& ensiie::Quaternion::operator-=(const Quaternion& q)
 {
+    QUATERNION_COUNT(Subtract);
     t -= q.t;
     u -= q.u;
     v -= q.v;
@@ -62,6 +183,7 @@ ensiie::Quaternion& ensiie::Quaternion::operator-=(const Quaternion& q)
 
 ensiie::Quaternion& ensiie::Quaternion::operator*=(const Quaternion& q)
 {
+    QUATERNION_COUNT(Multiply);
     double t1 = t;
     double u1 = u;
     double v1 = v;
@@ -75,8 +197,10 @@ ensiie::Quaternion& ensiie::Quaternion::operator*=(const Quaternion& q)
 
 ensiie::Quaternion& ensiie::Quaternion::operator/=(const Quaternion& q)
 {
+    QUATERNION_COUNT(Divide);
     if (q.norm() <= 1e-15)
     {
+        QUATERNION_FAULT(DivisionByZero);
         throw std::invalid_argument("Division by zero");
     }
     double t1 = t;
@@ -92,6 +216,7 @@ ensiie::Quaternion& ensiie::Quaternion::operator/=(const Quaternion& q)
 
 ensiie::Quaternion& ensiie::Quaternion::operator*=(double x)
 {
+    QUATERNION_COUNT(ScalarMultiply);
     t *= x;
     u *= x;
     v *= x;
@@ -101,8 +226,10 @@ ensiie::Quaternion& ensiie::Quaternion::operator*=(double x)
 
 ensiie::Quaternion& ensiie::Quaternion::operator/=(double x)
 {
+    QUATERNION_COUNT(ScalarDivide);
     if (std::abs(x) <= 1e-15)
     {
+        QUATERNION_FAULT(DivisionByZero);
         throw std::invalid_argument("Division by zero");
     }
     t /= x;
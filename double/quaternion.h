@@ -15,6 +15,7 @@
 #include <iostream>
 #include <cmath>
 #include <ostream>
+#include "quaternion_math.h"
 
 /**
  * @brief A namespace for the ENSIIE project.
@@ -147,6 +148,93 @@ namespace ensiie
          */
         static Quaternion inverse(const Quaternion& q) { return q.inverse(); };
 
+        /**
+         * @brief Gets the dot product of two quaternions, seen as vectors of R^4.
+         *
+         * @param q1 First.
+         * @param q2 Second.
+         * @return double Dot product.
+         */
+        static double dot(const Quaternion& q1, const Quaternion& q2) { return q1.t * q2.t + q1.u * q2.u + q1.v * q2.v + q1.w * q2.w; };
+
+        /**
+         * @brief Gets the unit quaternion with the same direction.
+         * @throws std::invalid_argument If the norm of the quaternion is 0.
+         * @return Quaternion Normalized quaternion.
+         */
+        Quaternion normalize() const;
+
+        /**
+         * @brief Gets the unit quaternion with the same direction.
+         * @throws std::invalid_argument If the norm of the quaternion is 0.
+         * @param q Quaternion.
+         * @return Quaternion Normalized q.
+         */
+        static Quaternion normalize(const Quaternion& q) { return q.normalize(); };
+
+        /**
+         * @brief Constructs the unit quaternion of a rotation given by an axis and an angle.
+         * @throws std::invalid_argument If the axis is null.
+         * @param x x coordinate of the axis.
+         * @param y y coordinate of the axis.
+         * @param z z coordinate of the axis.
+         * @param angle Angle of the rotation, in radians.
+         * @param accuracy Accuracy of the trigonometric functions.
+         * @return Quaternion Rotation quaternion.
+         */
+        static Quaternion fromAxisAngle(double x, double y, double z, double angle, Accuracy accuracy = Accuracy::Exact);
+
+        /**
+         * @brief Constructs the unit quaternion of a rotation matrix.
+         *
+         * @param m Rotation matrix, row-major.
+         * @return Quaternion Rotation quaternion, with a non-negative real part.
+         */
+        static Quaternion fromMatrix(const double m[9]);
+
+        /**
+         * @brief Gets the rotation matrix of a unit quaternion.
+         *
+         * @param m Rotation matrix, row-major.
+         */
+        void toMatrix(double m[9]) const;
+
+        /**
+         * @brief Rotates a vector by a unit quaternion, that is computes q * v * conjugate(q).
+         *
+         * @param x x coordinate, replaced by the rotated one.
+         * @param y y coordinate, replaced by the rotated one.
+         * @param z z coordinate, replaced by the rotated one.
+         */
+        void rotate(double& x, double& y, double& z) const;
+
+        /**
+         * @brief Spherical linear interpolation between two unit quaternions, along the shortest path.
+         *
+         * @param q1 Start, returned for s = 0.
+         * @param q2 End, returned for s = 1.
+         * @param s Interpolation parameter.
+         * @param accuracy Accuracy of the trigonometric functions.
+         * @return Quaternion Interpolated unit quaternion.
+         */
+        static Quaternion slerp(const Quaternion& q1, const Quaternion& q2, double s, Accuracy accuracy = Accuracy::Exact);
+
+        /**
+         * @brief Gets the exponential of the quaternion.
+         *
+         * @param accuracy Accuracy of the trigonometric functions.
+         * @return Quaternion Exponential.
+         */
+        Quaternion exp(Accuracy accuracy = Accuracy::Exact) const;
+
+        /**
+         * @brief Gets the principal logarithm of the quaternion.
+         * @throws std::invalid_argument If the quaternion is null.
+         * @param accuracy Accuracy of the trigonometric functions.
+         * @return Quaternion Logarithm.
+         */
+        Quaternion log(Accuracy accuracy = Accuracy::Exact) const;
+
         /**
          * @brief Adds two quaternions.
          * 
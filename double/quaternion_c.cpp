@@ -0,0 +1,604 @@
+/**
+ * @file quaternion_c.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Implements {@link quaternion_c.h}.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "quaternion_c.h"
+#include "quaternion.h"
+#include "quaternion_random.h"
+#include "quaternion_stats.h"
+#include <cmath>
+#include <cstdlib>
+#include <type_traits>
+
+namespace
+{
+    using Wxyz = std::integral_constant<int, QUAT_LAYOUT_WXYZ>;
+    using Xyzw = std::integral_constant<int, QUAT_LAYOUT_XYZW>;
+
+    template <int Layout>
+    inline ensiie::Quaternion load(const double* p)
+    {
+        if constexpr (Layout == QUAT_LAYOUT_XYZW)
+        {
+            return ensiie::Quaternion(p[3], p[0], p[1], p[2]);
+        }
+        else
+        {
+            return ensiie::Quaternion(p[0], p[1], p[2], p[3]);
+        }
+    }
+
+    template <int Layout>
+    inline void store(double* p, const ensiie::Quaternion& q)
+    {
+        // Read everything before writing, so that p may alias an input.
+        double t = q.getT(), u = q.getU(), v = q.getV(), w = q.getW();
+        if constexpr (Layout == QUAT_LAYOUT_XYZW)
+        {
+            p[0] = u;
+            p[1] = v;
+            p[2] = w;
+            p[3] = t;
+        }
+        else
+        {
+            p[0] = t;
+            p[1] = u;
+            p[2] = v;
+            p[3] = w;
+        }
+    }
+
+    bool validLayout(int layout)
+    {
+        return layout == QUAT_LAYOUT_WXYZ || layout == QUAT_LAYOUT_XYZW;
+    }
+
+    bool validOutput(size_t n, const double* out, ptrdiff_t stride, ptrdiff_t width)
+    {
+        return out != nullptr && (n <= 1 || std::abs(stride) >= width);
+    }
+
+    /**
+     * @brief Calls kernel with the layout as a compile-time constant, so that loops are specialized.
+     *
+     */
+    template <typename Kernel>
+    int dispatch(int layout, Kernel kernel)
+    {
+        if (layout == QUAT_LAYOUT_XYZW)
+        {
+            return kernel(Xyzw());
+        }
+        return kernel(Wxyz());
+    }
+
+    bool validAccuracy(int accuracy)
+    {
+        return accuracy == QUAT_ACCURACY_EXACT || accuracy == QUAT_ACCURACY_ULP || accuracy == QUAT_ACCURACY_FAST;
+    }
+
+    /**
+     * @brief Calls kernel with the accuracy as a compile-time constant.
+     *
+     */
+    template <typename Kernel>
+    int dispatchAccuracy(int accuracy, Kernel kernel)
+    {
+        if (accuracy == QUAT_ACCURACY_ULP)
+        {
+            return kernel(std::integral_constant<ensiie::Accuracy, ensiie::Accuracy::Ulp>());
+        }
+        if (accuracy == QUAT_ACCURACY_FAST)
+        {
+            return kernel(std::integral_constant<ensiie::Accuracy, ensiie::Accuracy::Fast>());
+        }
+        return kernel(std::integral_constant<ensiie::Accuracy, ensiie::Accuracy::Exact>());
+    }
+
+    ensiie::Accuracy toAccuracy(int accuracy)
+    {
+        return accuracy == QUAT_ACCURACY_ULP ? ensiie::Accuracy::Ulp
+                                             : (accuracy == QUAT_ACCURACY_FAST ? ensiie::Accuracy::Fast : ensiie::Accuracy::Exact);
+    }
+
+    /**
+     * @brief Runs a generator by blocks of a stack buffer, then stores the blocks with the requested layout.
+     *
+     */
+    template <typename Generator>
+    int generate(size_t n, double* q, ptrdiff_t stride_q, int layout, Generator generator)
+    {
+        return dispatch(layout, [&](auto l) {
+            constexpr int L = decltype(l)::value;
+            constexpr size_t block = 256;
+            ensiie::Quaternion buffer[block];
+            for (size_t start = 0; start < n; start += block)
+            {
+                size_t count = n - start < block ? n - start : block;
+                generator(start, buffer, count);
+                for (size_t i = 0; i < count; i++)
+                {
+                    store<L>(q + static_cast<ptrdiff_t>(start + i) * stride_q, buffer[i]);
+                }
+            }
+            return QUAT_OK;
+        });
+    }
+
+    /**
+     * @brief Elements staged in planes at a time by the kernels with trigonometric functions.
+     *
+     */
+    constexpr size_t STAGE = 256;
+
+    /**
+     * @brief Sine and cosine in the kernels: the approximations without any check, the domain having been checked
+     * for the whole stage, or <cmath> for Exact.
+     *
+     */
+    template <ensiie::Accuracy A>
+    inline void stageSincos(double x, double& s, double& c)
+    {
+        if constexpr (A == ensiie::Accuracy::Exact)
+        {
+            ensiie::math::sincos<A>(x, s, c);
+        }
+        else
+        {
+            ensiie::math::sincosUnchecked<A>(x, s, c);
+        }
+    }
+
+    template <ensiie::Accuracy A>
+    inline double stageSinc(double x)
+    {
+        if constexpr (A == ensiie::Accuracy::Exact)
+        {
+            return ensiie::math::sinc<A>(x);
+        }
+        else
+        {
+            return ensiie::math::sincUnchecked<A>(x);
+        }
+    }
+
+    template <ensiie::Accuracy A>
+    inline double stageAtan2(double y, double x)
+    {
+        if constexpr (A == ensiie::Accuracy::Exact)
+        {
+            return ensiie::math::atan2<A>(y, x);
+        }
+        else
+        {
+            return ensiie::math::atan2Unchecked<A>(y, x);
+        }
+    }
+
+    /**
+     * @brief Planes of a stage of quaternions.
+     *
+     */
+    struct Planes
+    {
+        double t[STAGE], u[STAGE], v[STAGE], w[STAGE];
+    };
+
+    template <int Layout>
+    inline void stage(const double* p, Planes& q, size_t i)
+    {
+        ensiie::Quaternion x = load<Layout>(p);
+        q.t[i] = x.getT();
+        q.u[i] = x.getU();
+        q.v[i] = x.getV();
+        q.w[i] = x.getW();
+    }
+
+    template <int Layout>
+    inline void unstage(double* p, const Planes& q, size_t i)
+    {
+        store<Layout>(p, ensiie::Quaternion(q.t[i], q.u[i], q.v[i], q.w[i]));
+    }
+
+    /**
+     * @brief Slerp of a stage, as Quaternion::slerp. Without branches for Ulp and Fast, so that the loop is vectorized.
+     *
+     */
+    template <ensiie::Accuracy A>
+    void slerpStage(const Planes& a, const Planes& b, const double* __restrict s, Planes& out, size_t count)
+    {
+        const double* __restrict at = a.t;
+        const double* __restrict au = a.u;
+        const double* __restrict av = a.v;
+        const double* __restrict aw = a.w;
+        const double* __restrict bt = b.t;
+        const double* __restrict bu = b.u;
+        const double* __restrict bv = b.v;
+        const double* __restrict bw = b.w;
+        double* __restrict ot = out.t;
+        double* __restrict ou = out.u;
+        double* __restrict ov = out.v;
+        double* __restrict ow = out.w;
+        for (size_t i = 0; i < count; i++)
+        {
+            // The shortest path, to -b if b is in the other half space.
+            double sign = at[i] * bt[i] + au[i] * bu[i] + av[i] * bv[i] + aw[i] * bw[i] < 0 ? -1 : 1;
+            double et = sign * bt[i], eu = sign * bu[i], ev = sign * bv[i], ew = sign * bw[i];
+            double dt = at[i] - et, du = au[i] - eu, dv = av[i] - ev, dw = aw[i] - ew;
+            double mt = at[i] + et, mu = au[i] + eu, mv = av[i] + ev, mw = aw[i] + ew;
+            double theta = 2 * stageAtan2<A>(std::sqrt(dt * dt + du * du + dv * dv + dw * dw),
+                                             std::sqrt(mt * mt + mu * mu + mv * mv + mw * mw));
+            double k = 1 / stageSinc<A>(theta);
+            double ka = (1 - s[i]) * stageSinc<A>((1 - s[i]) * theta) * k;
+            double kb = s[i] * stageSinc<A>(s[i] * theta) * k;
+            ot[i] = at[i] * ka + et * kb;
+            ou[i] = au[i] * ka + eu * kb;
+            ov[i] = av[i] * ka + ev * kb;
+            ow[i] = aw[i] * ka + ew * kb;
+        }
+    }
+
+    /**
+     * @brief Rotations of a stage of axes and half angles, the identity for a null axis. Without branches for Ulp
+     * and Fast, so that the loop is vectorized.
+     *
+     */
+    template <ensiie::Accuracy A>
+    void axisAngleStage(const double* __restrict x, const double* __restrict y, const double* __restrict z,
+                        const double* __restrict half, Planes& out, size_t count)
+    {
+        double* __restrict ot = out.t;
+        double* __restrict ou = out.u;
+        double* __restrict ov = out.v;
+        double* __restrict ow = out.w;
+        for (size_t i = 0; i < count; i++)
+        {
+            double n2 = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+            double s, c;
+            stageSincos<A>(half[i], s, c);
+            bool zero = n2 <= 1e-30;
+            s = zero ? 0 : s / std::sqrt(zero ? 1 : n2);
+            ot[i] = zero ? 1 : c;
+            ou[i] = x[i] * s;
+            ov[i] = y[i] * s;
+            ow[i] = z[i] * s;
+        }
+    }
+}
+
+int quat_abi_version(void)
+{
+    return QUAT_ABI_VERSION;
+}
+
+int quat_multiply(size_t n, const double* a, ptrdiff_t stride_a, const double* b, ptrdiff_t stride_b,
+                  double* out, ptrdiff_t stride_out, int layout)
+{
+    if (n == 0)
+    {
+        return QUAT_OK;
+    }
+    if (!a || !b || !validLayout(layout) || !validOutput(n, out, stride_out, 4))
+    {
+        return QUAT_EINVAL;
+    }
+    QUATERNION_KERNEL(Multiply, n);
+    return dispatch(layout, [&](auto l) {
+        constexpr int L = decltype(l)::value;
+        for (size_t i = 0; i < n; i++)
+        {
+            ptrdiff_t k = static_cast<ptrdiff_t>(i);
+            store<L>(out + k * stride_out, load<L>(a + k * stride_a) * load<L>(b + k * stride_b));
+        }
+        return QUAT_OK;
+    });
+}
+
+int quat_rotate(size_t n, const double* q, ptrdiff_t stride_q, const double* v, ptrdiff_t stride_v,
+                double* out, ptrdiff_t stride_out, int layout)
+{
+    if (n == 0)
+    {
+        return QUAT_OK;
+    }
+    if (!q || !v || !validLayout(layout) || !validOutput(n, out, stride_out, 3))
+    {
+        return QUAT_EINVAL;
+    }
+    QUATERNION_KERNEL(Rotate, n);
+    return dispatch(layout, [&](auto l) {
+        constexpr int L = decltype(l)::value;
+        for (size_t i = 0; i < n; i++)
+        {
+            ptrdiff_t k = static_cast<ptrdiff_t>(i);
+            const double* p = v + k * stride_v;
+            double x = p[0], y = p[1], z = p[2];
+            load<L>(q + k * stride_q).rotate(x, y, z);
+            double* o = out + k * stride_out;
+            o[0] = x;
+            o[1] = y;
+            o[2] = z;
+        }
+        return QUAT_OK;
+    });
+}
+
+int quat_normalize(size_t n, const double* q, ptrdiff_t stride_q, double* out, ptrdiff_t stride_out, int layout)
+{
+    if (n == 0)
+    {
+        return QUAT_OK;
+    }
+    if (!q || !validLayout(layout) || !validOutput(n, out, stride_out, 4))
+    {
+        return QUAT_EINVAL;
+    }
+    QUATERNION_KERNEL(Normalize, n);
+    return dispatch(layout, [&](auto l) {
+        constexpr int L = decltype(l)::value;
+        int status = QUAT_OK;
+        for (size_t i = 0; i < n; i++)
+        {
+            ptrdiff_t k = static_cast<ptrdiff_t>(i);
+            ensiie::Quaternion x = load<L>(q + k * stride_q);
+            double norm = x.norm();
+            if (norm <= 1e-15)
+            {
+                status = QUAT_EDOMAIN;
+            }
+            else
+            {
+                x *= 1 / norm;
+            }
+            store<L>(out + k * stride_out, x);
+        }
+        if (status != QUAT_OK)
+        {
+            QUATERNION_FAULT(Domain);
+        }
+        return status;
+    });
+}
+
+int quat_slerp(size_t n, const double* a, ptrdiff_t stride_a, const double* b, ptrdiff_t stride_b,
+               const double* s, ptrdiff_t stride_s, double* out, ptrdiff_t stride_out, int layout)
+{
+    return quat_slerp_ex(n, a, stride_a, b, stride_b, s, stride_s, out, stride_out, layout, QUAT_ACCURACY_EXACT);
+}
+
+int quat_slerp_ex(size_t n, const double* a, ptrdiff_t stride_a, const double* b, ptrdiff_t stride_b,
+                  const double* s, ptrdiff_t stride_s, double* out, ptrdiff_t stride_out, int layout, int accuracy)
+{
+    if (n == 0)
+    {
+        return QUAT_OK;
+    }
+    if (!a || !b || !s || !validLayout(layout) || !validAccuracy(accuracy) || !validOutput(n, out, stride_out, 4))
+    {
+        return QUAT_EINVAL;
+    }
+    QUATERNION_KERNEL(Slerp, n);
+    return dispatch(layout, [&](auto l) {
+        constexpr int L = decltype(l)::value;
+        return dispatchAccuracy(accuracy, [&](auto x) {
+            constexpr ensiie::Accuracy A = decltype(x)::value;
+            // Strided inputs are staged in planes, then computed without branches. A whole stage is read before
+            // it is written, so that out may alias an input.
+            Planes qa, qb, result;
+            double parameters[STAGE];
+            for (size_t start = 0; start < n; start += STAGE)
+            {
+                size_t count = n - start < STAGE ? n - start : STAGE;
+                bool inDomain = true;
+                for (size_t i = 0; i < count; i++)
+                {
+                    ptrdiff_t k = static_cast<ptrdiff_t>(start + i);
+                    stage<L>(a + k * stride_a, qa, i);
+                    stage<L>(b + k * stride_b, qb, i);
+                    parameters[i] = s[k * stride_s];
+                    // The angles (1 - s) theta and s theta, theta <= pi, are checked once per stage, and so are finite
+                    // norms for the approximation of atan2.
+                    double magnitude = std::abs(qa.t[i]) + std::abs(qa.u[i]) + std::abs(qa.v[i]) + std::abs(qa.w[i]) +
+                                       std::abs(qb.t[i]) + std::abs(qb.u[i]) + std::abs(qb.v[i]) + std::abs(qb.w[i]);
+                    inDomain &= (std::abs(parameters[i]) + 1) * ensiie::math::PI < ensiie::math::SINCOS_DOMAIN && magnitude < 1e150;
+                }
+                if (inDomain)
+                {
+                    slerpStage<A>(qa, qb, parameters, result, count);
+                }
+                else
+                {
+                    slerpStage<ensiie::Accuracy::Exact>(qa, qb, parameters, result, count);
+                }
+                for (size_t i = 0; i < count; i++)
+                {
+                    unstage<L>(out + static_cast<ptrdiff_t>(start + i) * stride_out, result, i);
+                }
+            }
+            return QUAT_OK;
+        });
+    });
+}
+
+int quat_to_matrix(size_t n, const double* q, ptrdiff_t stride_q, double* m, ptrdiff_t stride_m, int layout)
+{
+    if (n == 0)
+    {
+        return QUAT_OK;
+    }
+    if (!q || !validLayout(layout) || !validOutput(n, m, stride_m, 9))
+    {
+        return QUAT_EINVAL;
+    }
+    QUATERNION_KERNEL(ToMatrix, n);
+    return dispatch(layout, [&](auto l) {
+        constexpr int L = decltype(l)::value;
+        for (size_t i = 0; i < n; i++)
+        {
+            ptrdiff_t k = static_cast<ptrdiff_t>(i);
+            double r[9];
+            load<L>(q + k * stride_q).toMatrix(r);
+            double* o = m + k * stride_m;
+            for (int j = 0; j < 9; j++)
+            {
+                o[j] = r[j];
+            }
+        }
+        return QUAT_OK;
+    });
+}
+
+int quat_from_matrix(size_t n, const double* m, ptrdiff_t stride_m, double* q, ptrdiff_t stride_q, int layout)
+{
+    if (n == 0)
+    {
+        return QUAT_OK;
+    }
+    if (!m || !validLayout(layout) || !validOutput(n, q, stride_q, 4))
+    {
+        return QUAT_EINVAL;
+    }
+    QUATERNION_KERNEL(FromMatrix, n);
+    return dispatch(layout, [&](auto l) {
+        constexpr int L = decltype(l)::value;
+        for (size_t i = 0; i < n; i++)
+        {
+            ptrdiff_t k = static_cast<ptrdiff_t>(i);
+            store<L>(q + k * stride_q, ensiie::Quaternion::fromMatrix(m + k * stride_m));
+        }
+        return QUAT_OK;
+    });
+}
+
+int quat_from_axis_angle(size_t n, const double* axis, ptrdiff_t stride_axis, const double* angle,
+                         ptrdiff_t stride_angle, double* q, ptrdiff_t stride_q, int layout)
+{
+    return quat_from_axis_angle_ex(n, axis, stride_axis, angle, stride_angle, q, stride_q, layout, QUAT_ACCURACY_EXACT);
+}
+
+int quat_from_axis_angle_ex(size_t n, const double* axis, ptrdiff_t stride_axis, const double* angle,
+                            ptrdiff_t stride_angle, double* q, ptrdiff_t stride_q, int layout, int accuracy)
+{
+    if (n == 0)
+    {
+        return QUAT_OK;
+    }
+    if (!axis || !angle || !validLayout(layout) || !validAccuracy(accuracy) || !validOutput(n, q, stride_q, 4))
+    {
+        return QUAT_EINVAL;
+    }
+    QUATERNION_KERNEL(FromAxisAngle, n);
+    return dispatch(layout, [&](auto l) {
+        constexpr int L = decltype(l)::value;
+        return dispatchAccuracy(accuracy, [&](auto x) {
+            constexpr ensiie::Accuracy A = decltype(x)::value;
+            // Strided inputs are staged in planes, then computed without branches. A whole stage is read before
+            // it is written, so that q may alias an input.
+            double ax[STAGE], ay[STAGE], az[STAGE], half[STAGE];
+            Planes result;
+            bool null = false;
+            for (size_t start = 0; start < n; start += STAGE)
+            {
+                size_t count = n - start < STAGE ? n - start : STAGE;
+                bool inDomain = true;
+                for (size_t i = 0; i < count; i++)
+                {
+                    ptrdiff_t k = static_cast<ptrdiff_t>(start + i);
+                    const double* p = axis + k * stride_axis;
+                    ax[i] = p[0];
+                    ay[i] = p[1];
+                    az[i] = p[2];
+                    half[i] = angle[k * stride_angle] / 2;
+                    // Checked once per stage rather than in the kernel, like the null axes.
+                    inDomain &= std::abs(half[i]) < ensiie::math::SINCOS_DOMAIN;
+                    null |= ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i] <= 1e-30;
+                }
+                if (inDomain)
+                {
+                    axisAngleStage<A>(ax, ay, az, half, result, count);
+                }
+                else
+                {
+                    axisAngleStage<ensiie::Accuracy::Exact>(ax, ay, az, half, result, count);
+                }
+                for (size_t i = 0; i < count; i++)
+                {
+                    unstage<L>(q + static_cast<ptrdiff_t>(start + i) * stride_q, result, i);
+                }
+            }
+            if (null)
+            {
+                QUATERNION_FAULT(Domain);
+            }
+            return null ? QUAT_EDOMAIN : QUAT_OK;
+        });
+    });
+}
+
+int quat_random_uniform(uint64_t seed, uint64_t first, size_t n, double* q, ptrdiff_t stride_q, int layout, int accuracy)
+{
+    if (n == 0)
+    {
+        return QUAT_OK;
+    }
+    if (!validLayout(layout) || !validAccuracy(accuracy) || !validOutput(n, q, stride_q, 4))
+    {
+        return QUAT_EINVAL;
+    }
+    QUATERNION_KERNEL(RandomUniform, n);
+    return generate(n, q, stride_q, layout, [&](size_t start, ensiie::Quaternion* buffer, size_t count) {
+        ensiie::uniformRotations(seed, first + start, buffer, count, toAccuracy(accuracy));
+    });
+}
+
+int quat_random_perturbed(const double* mean, double sigma, uint64_t seed, uint64_t first, size_t n,
+                          double* q, ptrdiff_t stride_q, int layout, int accuracy)
+{
+    if (n == 0)
+    {
+        return QUAT_OK;
+    }
+    if (!mean || !validLayout(layout) || !validAccuracy(accuracy) || !validOutput(n, q, stride_q, 4))
+    {
+        return QUAT_EINVAL;
+    }
+    QUATERNION_KERNEL(RandomPerturbed, n);
+    ensiie::Quaternion m = layout == QUAT_LAYOUT_XYZW ? load<QUAT_LAYOUT_XYZW>(mean) : load<QUAT_LAYOUT_WXYZ>(mean);
+    return generate(n, q, stride_q, layout, [&](size_t start, ensiie::Quaternion* buffer, size_t count) {
+        ensiie::perturbedRotations(m, sigma, seed, first + start, buffer, count, toAccuracy(accuracy));
+    });
+}
+
+int quat_convert_layout(size_t n, const double* in, ptrdiff_t stride_in, int layout_in,
+                        double* out, ptrdiff_t stride_out, int layout_out)
+{
+    if (n == 0)
+    {
+        return QUAT_OK;
+    }
+    if (!in || !validLayout(layout_in) || !validLayout(layout_out) || !validOutput(n, out, stride_out, 4))
+    {
+        return QUAT_EINVAL;
+    }
+    QUATERNION_KERNEL(ConvertLayout, n);
+    return dispatch(layout_in, [&](auto l) {
+        constexpr int L = decltype(l)::value;
+        return dispatch(layout_out, [&](auto m) {
+            constexpr int M = decltype(m)::value;
+            for (size_t i = 0; i < n; i++)
+            {
+                ptrdiff_t k = static_cast<ptrdiff_t>(i);
+                store<M>(out + k * stride_out, load<L>(in + k * stride_in));
+            }
+            return QUAT_OK;
+        });
+    });
+}
@@ -0,0 +1,258 @@
+/**
+ * @file quaternion_c.h
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Provides a stable C interface to batches of quaternions stored in caller-owned buffers.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Every function works on @p n elements. An element is read at @c p + i * stride, strides being
+ * counted in doubles (divide NumPy byte strides by @c sizeof(double)), so interleaved records and
+ * negative strides are supported. An input stride of 0 broadcasts a single element to the whole batch.
+ * Outputs may alias inputs exactly, which allows in-place updates. Nothing is copied or allocated.
+ *
+ */
+
+#ifndef QUATERNION_C_H
+#define QUATERNION_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Version of the C interface, bumped on any incompatible change.
+     *
+     */
+#define QUAT_ABI_VERSION 1
+
+    /**
+     * @brief Real part first: t, u, v, w.
+     *
+     */
+#define QUAT_LAYOUT_WXYZ 0
+    /**
+     * @brief Real part last: u, v, w, t.
+     *
+     */
+#define QUAT_LAYOUT_XYZW 1
+
+    /**
+     * @brief Success.
+     *
+     */
+#define QUAT_OK 0
+    /**
+     * @brief Invalid argument: null pointer, unknown layout or output stride too small. Nothing is written.
+     *
+     */
+#define QUAT_EINVAL (-1)
+    /**
+     * @brief At least one element had no valid result (null norm or null axis). The other elements are computed.
+     *
+     */
+#define QUAT_EDOMAIN (-2)
+
+    /**
+     * @brief Trigonometric functions of the C library.
+     *
+     */
+#define QUAT_ACCURACY_EXACT 0
+    /**
+     * @brief Polynomial approximations within a few ULP.
+     *
+     */
+#define QUAT_ACCURACY_ULP 1
+    /**
+     * @brief Polynomial approximations within 1e-7 absolute, the fastest.
+     *
+     */
+#define QUAT_ACCURACY_FAST 2
+
+    /**
+     * @brief Gets the version of the C interface the library was built with.
+     *
+     * @return int QUAT_ABI_VERSION.
+     */
+    int quat_abi_version(void);
+
+    /**
+     * @brief Multiplies quaternions: out[i] = a[i] * b[i].
+     *
+     * @param n Number of elements.
+     * @param a Left operands.
+     * @param stride_a Stride of a.
+     * @param b Right operands.
+     * @param stride_b Stride of b.
+     * @param out Products.
+     * @param stride_out Stride of out.
+     * @param layout QUAT_LAYOUT_WXYZ or QUAT_LAYOUT_XYZW.
+     * @return int QUAT_OK or QUAT_EINVAL.
+     */
+    int quat_multiply(size_t n, const double* a, ptrdiff_t stride_a, const double* b, ptrdiff_t stride_b,
+                      double* out, ptrdiff_t stride_out, int layout);
+
+    /**
+     * @brief Rotates 3D vectors by unit quaternions: out[i] = q[i] * v[i] * conjugate(q[i]).
+     *
+     * @param n Number of elements.
+     * @param q Unit quaternions.
+     * @param stride_q Stride of q.
+     * @param v Vectors, as x, y, z.
+     * @param stride_v Stride of v.
+     * @param out Rotated vectors.
+     * @param stride_out Stride of out, at least 3.
+     * @param layout Layout of q.
+     * @return int QUAT_OK or QUAT_EINVAL.
+     */
+    int quat_rotate(size_t n, const double* q, ptrdiff_t stride_q, const double* v, ptrdiff_t stride_v,
+                    double* out, ptrdiff_t stride_out, int layout);
+
+    /**
+     * @brief Normalizes quaternions. Null quaternions are copied unchanged.
+     *
+     * @param n Number of elements.
+     * @param q Quaternions.
+     * @param stride_q Stride of q.
+     * @param out Unit quaternions, may be q.
+     * @param stride_out Stride of out.
+     * @param layout QUAT_LAYOUT_WXYZ or QUAT_LAYOUT_XYZW.
+     * @return int QUAT_OK, QUAT_EDOMAIN if a quaternion was null, or QUAT_EINVAL.
+     */
+    int quat_normalize(size_t n, const double* q, ptrdiff_t stride_q, double* out, ptrdiff_t stride_out, int layout);
+
+    /**
+     * @brief Spherical linear interpolation between unit quaternions, along the shortest path.
+     *
+     * @param n Number of elements.
+     * @param a Starts.
+     * @param stride_a Stride of a.
+     * @param b Ends.
+     * @param stride_b Stride of b.
+     * @param s Interpolation parameters, 0 giving a and 1 giving b.
+     * @param stride_s Stride of s, 0 for a single parameter.
+     * @param out Interpolated quaternions.
+     * @param stride_out Stride of out.
+     * @param layout QUAT_LAYOUT_WXYZ or QUAT_LAYOUT_XYZW.
+     * @return int QUAT_OK or QUAT_EINVAL.
+     */
+    int quat_slerp(size_t n, const double* a, ptrdiff_t stride_a, const double* b, ptrdiff_t stride_b,
+                   const double* s, ptrdiff_t stride_s, double* out, ptrdiff_t stride_out, int layout);
+
+    /**
+     * @brief Same as quat_slerp, with a selectable accuracy.
+     *
+     * @param accuracy QUAT_ACCURACY_EXACT, QUAT_ACCURACY_ULP or QUAT_ACCURACY_FAST.
+     * @return int QUAT_OK or QUAT_EINVAL.
+     */
+    int quat_slerp_ex(size_t n, const double* a, ptrdiff_t stride_a, const double* b, ptrdiff_t stride_b,
+                      const double* s, ptrdiff_t stride_s, double* out, ptrdiff_t stride_out, int layout, int accuracy);
+
+    /**
+     * @brief Converts unit quaternions to row-major rotation matrices.
+     *
+     * @param n Number of elements.
+     * @param q Unit quaternions.
+     * @param stride_q Stride of q.
+     * @param m Matrices, 9 doubles each.
+     * @param stride_m Stride of m, at least 9.
+     * @param layout Layout of q.
+     * @return int QUAT_OK or QUAT_EINVAL.
+     */
+    int quat_to_matrix(size_t n, const double* q, ptrdiff_t stride_q, double* m, ptrdiff_t stride_m, int layout);
+
+    /**
+     * @brief Converts row-major rotation matrices to unit quaternions with a non-negative real part.
+     *
+     * @param n Number of elements.
+     * @param m Matrices, 9 doubles each.
+     * @param stride_m Stride of m.
+     * @param q Unit quaternions.
+     * @param stride_q Stride of q.
+     * @param layout Layout of q.
+     * @return int QUAT_OK or QUAT_EINVAL.
+     */
+    int quat_from_matrix(size_t n, const double* m, ptrdiff_t stride_m, double* q, ptrdiff_t stride_q, int layout);
+
+    /**
+     * @brief Converts axis-angle rotations to unit quaternions. A null axis gives the identity.
+     *
+     * @param n Number of elements.
+     * @param axis Axes, as x, y, z, not necessarily unit.
+     * @param stride_axis Stride of axis.
+     * @param angle Angles, in radians.
+     * @param stride_angle Stride of angle.
+     * @param q Unit quaternions.
+     * @param stride_q Stride of q.
+     * @param layout Layout of q.
+     * @return int QUAT_OK, QUAT_EDOMAIN if an axis was null, or QUAT_EINVAL.
+     */
+    int quat_from_axis_angle(size_t n, const double* axis, ptrdiff_t stride_axis, const double* angle,
+                             ptrdiff_t stride_angle, double* q, ptrdiff_t stride_q, int layout);
+
+    /**
+     * @brief Same as quat_from_axis_angle, with a selectable accuracy.
+     *
+     * @param accuracy QUAT_ACCURACY_EXACT, QUAT_ACCURACY_ULP or QUAT_ACCURACY_FAST.
+     * @return int QUAT_OK, QUAT_EDOMAIN if an axis was null, or QUAT_EINVAL.
+     */
+    int quat_from_axis_angle_ex(size_t n, const double* axis, ptrdiff_t stride_axis, const double* angle,
+                                ptrdiff_t stride_angle, double* q, ptrdiff_t stride_q, int layout, int accuracy);
+
+    /**
+     * @brief Generates uniformly distributed rotations. Draw k only depends on (seed, k), so batches
+     * split between threads give the same rotations as a single batch.
+     *
+     * @param seed Seed of the sequence.
+     * @param first Index in the sequence of the first draw.
+     * @param n Number of rotations.
+     * @param q Unit quaternions, q[i] being draw first + i.
+     * @param stride_q Stride of q.
+     * @param layout Layout of q.
+     * @param accuracy QUAT_ACCURACY_EXACT, QUAT_ACCURACY_ULP or QUAT_ACCURACY_FAST.
+     * @return int QUAT_OK or QUAT_EINVAL.
+     */
+    int quat_random_uniform(uint64_t seed, uint64_t first, size_t n, double* q, ptrdiff_t stride_q, int layout, int accuracy);
+
+    /**
+     * @brief Generates random rotations around a mean: mean * exp(v / 2), v having independent normal coordinates.
+     *
+     * @param mean Mean rotation, a unit quaternion.
+     * @param sigma Standard deviation of each coordinate of v, in radians.
+     * @param seed Seed of the sequence.
+     * @param first Index in the sequence of the first draw.
+     * @param n Number of rotations.
+     * @param q Unit quaternions, q[i] being draw first + i.
+     * @param stride_q Stride of q.
+     * @param layout Layout of mean and q.
+     * @param accuracy QUAT_ACCURACY_EXACT, QUAT_ACCURACY_ULP or QUAT_ACCURACY_FAST.
+     * @return int QUAT_OK or QUAT_EINVAL.
+     */
+    int quat_random_perturbed(const double* mean, double sigma, uint64_t seed, uint64_t first, size_t n,
+                              double* q, ptrdiff_t stride_q, int layout, int accuracy);
+
+    /**
+     * @brief Converts quaternions from one layout to another.
+     *
+     * @param n Number of elements.
+     * @param in Quaternions.
+     * @param stride_in Stride of in.
+     * @param layout_in Layout of in.
+     * @param out Converted quaternions, may be in.
+     * @param stride_out Stride of out.
+     * @param layout_out Layout of out.
+     * @return int QUAT_OK or QUAT_EINVAL.
+     */
+    int quat_convert_layout(size_t n, const double* in, ptrdiff_t stride_in, int layout_in,
+                            double* out, ptrdiff_t stride_out, int layout_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // QUATERNION_C_H
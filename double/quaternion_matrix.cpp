@@ -0,0 +1,280 @@
+/**
+ * @file quaternion_matrix.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Implements {@link quaternion_matrix.h}.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "quaternion_matrix.h"
+#include "quaternion_stats.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Rows of c per task.
+     *
+     */
+    constexpr std::size_t TASK_ROWS = 64;
+    /**
+     * @brief Columns of c per task, so that matrices with few rows are still split between threads.
+     *
+     */
+    constexpr std::size_t TASK_COLS = 256;
+    /**
+     * @brief Quaternion multiply-adds per thread under which no more threads are started, starting a thread
+     * costing about as much.
+     *
+     */
+    constexpr std::size_t THREAD_WORK = std::size_t(1) << 16;
+    /**
+     * @brief Depth of a tile: a packed tile of b (TILE_DEPTH x TILE_WIDTH quaternions, 256 KB) stays in the L2 cache.
+     *
+     */
+    constexpr std::size_t TILE_DEPTH = 128;
+    /**
+     * @brief Width of a tile, a divisor of TASK_COLS.
+     *
+     */
+    constexpr std::size_t TILE_WIDTH = 64;
+    /**
+     * @brief Columns of c of a register block: one vector register per component and row.
+     *
+     */
+#if defined(__AVX512F__)
+    constexpr std::size_t BLOCK_COLS = 8;
+#elif defined(__AVX__)
+    constexpr std::size_t BLOCK_COLS = 4;
+#else
+    constexpr std::size_t BLOCK_COLS = 2;
+#endif
+    /**
+     * @brief Rows of c of a register block, which share each load of b.
+     *
+     */
+    constexpr std::size_t BLOCK_ROWS = 2;
+
+    /**
+     * @brief Copies the columns [j0, j1) of the rows [k0, k1) of b into panels of BLOCK_COLS columns: for each
+     * panel, then each row, the BLOCK_COLS values of t, u, v and w. The last panel is padded with zeros.
+     *
+     */
+    void pack(const double* const* b, std::size_t ldb, std::size_t k0, std::size_t k1, std::size_t j0, std::size_t j1,
+              double* packed)
+    {
+        for (std::size_t j = j0; j < j1; j += BLOCK_COLS)
+        {
+            std::size_t n = std::min(BLOCK_COLS, j1 - j);
+            for (std::size_t k = k0; k < k1; k++)
+            {
+                for (int p = 0; p < 4; p++)
+                {
+                    const double* row = b[p] + k * ldb + j;
+                    for (std::size_t x = 0; x < BLOCK_COLS; x++)
+                    {
+                        packed[x] = x < n ? row[x] : 0;
+                    }
+                    packed += BLOCK_COLS;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief BLOCK_COLS doubles, in vector registers.
+     *
+     */
+    typedef double Lanes __attribute__((vector_size(BLOCK_COLS * sizeof(double))));
+
+    /**
+     * @brief Micro-kernel: c(i .. i + R, j .. j + n) += a(i .. i + R, k0 .. k0 + depth) * panel, n <= BLOCK_COLS.
+     *
+     * The R x BLOCK_COLS block of c stays in registers over the whole depth, so that each step of k only loads
+     * R quaternions of a and BLOCK_COLS quaternions of the panel for 16 R BLOCK_COLS multiplications.
+     */
+    template <std::size_t R>
+    inline void block(const double* const* a, std::size_t lda, const double* __restrict panel, double* const* c,
+                      std::size_t ldc, std::size_t i, std::size_t j, std::size_t n, std::size_t k0, std::size_t depth)
+    {
+        Lanes ct[R] = {}, cu[R] = {}, cv[R] = {}, cw[R] = {};
+        for (std::size_t k = 0; k < depth; k++)
+        {
+            Lanes bt, bu, bv, bw;
+            std::memcpy(&bt, panel + 4 * BLOCK_COLS * k, sizeof(Lanes));
+            std::memcpy(&bu, panel + 4 * BLOCK_COLS * k + BLOCK_COLS, sizeof(Lanes));
+            std::memcpy(&bv, panel + 4 * BLOCK_COLS * k + 2 * BLOCK_COLS, sizeof(Lanes));
+            std::memcpy(&bw, panel + 4 * BLOCK_COLS * k + 3 * BLOCK_COLS, sizeof(Lanes));
+            for (std::size_t r = 0; r < R; r++)
+            {
+                std::size_t x = (i + r) * lda + k0 + k;
+                double p = a[0][x], q = a[1][x], s = a[2][x], t = a[3][x];
+                ct[r] += p * bt - q * bu - s * bv - t * bw;
+                cu[r] += p * bu + q * bt + s * bw - t * bv;
+                cv[r] += p * bv - q * bw + s * bt + t * bu;
+                cw[r] += p * bw + q * bv - s * bu + t * bt;
+            }
+        }
+        for (std::size_t r = 0; r < R; r++)
+        {
+            for (std::size_t y = 0; y < n; y++)
+            {
+                std::size_t x = (i + r) * ldc + j + y;
+                c[0][x] += ct[r][y];
+                c[1][x] += cu[r][y];
+                c[2][x] += cv[r][y];
+                c[3][x] += cw[r][y];
+            }
+        }
+    }
+
+    /**
+     * @brief Computes the block [i0, i1) x [j0, j1) of c, tile by tile.
+     *
+     */
+    void task(const ensiie::QuaternionMatrix& a, const ensiie::QuaternionMatrix& b, ensiie::QuaternionMatrix& c,
+              std::size_t i0, std::size_t i1, std::size_t j0, std::size_t j1, std::vector<double>& packed)
+    {
+        const double* pa[4] = {a.plane(0), a.plane(1), a.plane(2), a.plane(3)};
+        const double* pb[4] = {b.plane(0), b.plane(1), b.plane(2), b.plane(3)};
+        double* pc[4] = {c.plane(0), c.plane(1), c.plane(2), c.plane(3)};
+        std::size_t depth = a.getCols();
+        std::size_t width = b.getCols();
+        packed.resize(4 * TILE_DEPTH * TILE_WIDTH);
+        for (std::size_t k0 = 0; k0 < depth; k0 += TILE_DEPTH)
+        {
+            std::size_t k1 = std::min(depth, k0 + TILE_DEPTH);
+            for (std::size_t t0 = j0; t0 < j1; t0 += TILE_WIDTH)
+            {
+                std::size_t t1 = std::min(j1, t0 + TILE_WIDTH);
+                pack(pb, width, k0, k1, t0, t1, packed.data());
+                // A panel stays in the L1 cache while it is multiplied by every row of the task.
+                for (std::size_t j = t0; j < t1; j += BLOCK_COLS)
+                {
+                    const double* panel = packed.data() + (j - t0) * 4 * (k1 - k0);
+                    std::size_t n = std::min(BLOCK_COLS, t1 - j);
+                    std::size_t i = i0;
+                    for (; i + BLOCK_ROWS <= i1; i += BLOCK_ROWS)
+                    {
+                        block<BLOCK_ROWS>(pa, depth, panel, pc, width, i, j, n, k0, k1 - k0);
+                    }
+                    for (; i < i1; i++)
+                    {
+                        block<1>(pa, depth, panel, pc, width, i, j, n, k0, k1 - k0);
+                    }
+                }
+            }
+        }
+    }
+}
+
+ensiie::QuaternionMatrix::QuaternionMatrix() : rows(0), cols(0)
+{
+}
+
+ensiie::QuaternionMatrix::QuaternionMatrix(std::size_t rows, std::size_t cols) : rows(rows), cols(cols)
+{
+    for (std::vector<double>& p : planes)
+    {
+        p.assign(rows * cols, 0);
+    }
+}
+
+ensiie::QuaternionMatrix::~QuaternionMatrix()
+{
+}
+
+ensiie::Quaternion ensiie::QuaternionMatrix::get(std::size_t i, std::size_t j) const
+{
+    std::size_t k = i * cols + j;
+    return Quaternion(planes[0][k], planes[1][k], planes[2][k], planes[3][k]);
+}
+
+void ensiie::QuaternionMatrix::set(std::size_t i, std::size_t j, const Quaternion& q)
+{
+    std::size_t k = i * cols + j;
+    planes[0][k] = q.getT();
+    planes[1][k] = q.getU();
+    planes[2][k] = q.getV();
+    planes[3][k] = q.getW();
+}
+
+ensiie::QuaternionMatrix& ensiie::QuaternionMatrix::operator+=(const QuaternionMatrix& m)
+{
+    if (rows != m.rows || cols != m.cols)
+    {
+        throw std::invalid_argument("Incompatible dimensions");
+    }
+    for (int p = 0; p < 4; p++)
+    {
+        for (std::size_t k = 0; k < rows * cols; k++)
+        {
+            planes[p][k] += m.planes[p][k];
+        }
+    }
+    return *this;
+}
+
+bool ensiie::QuaternionMatrix::operator==(const QuaternionMatrix& m) const
+{
+    return rows == m.rows && cols == m.cols && planes[0] == m.planes[0] && planes[1] == m.planes[1] &&
+           planes[2] == m.planes[2] && planes[3] == m.planes[3];
+}
+
+void ensiie::gemm(const QuaternionMatrix& a, const QuaternionMatrix& b, QuaternionMatrix& c, unsigned threads)
+{
+    if (a.getCols() != b.getRows() || c.getRows() != a.getRows() || c.getCols() != b.getCols())
+    {
+        throw std::invalid_argument("Incompatible dimensions");
+    }
+    if (&c == &a || &c == &b)
+    {
+        throw std::invalid_argument("The result must be distinct from the factors");
+    }
+    QUATERNION_KERNEL(Gemm, a.getRows() * a.getCols() * b.getCols());
+    std::size_t rowTasks = (a.getRows() + TASK_ROWS - 1) / TASK_ROWS;
+    std::size_t colTasks = (b.getCols() + TASK_COLS - 1) / TASK_COLS;
+    std::size_t tasks = rowTasks * colTasks;
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // Small products run on the calling thread.
+    std::size_t work = a.getRows() * a.getCols() * b.getCols();
+    threads = static_cast<unsigned>(std::min({std::size_t(threads), tasks, std::max<std::size_t>(1, work / THREAD_WORK)}));
+
+    std::atomic<std::size_t> next(0);
+    auto worker = [&] {
+        std::vector<double> packed;
+        for (std::size_t t = next++; t < tasks; t = next++)
+        {
+            std::size_t i = t / colTasks * TASK_ROWS, j = t % colTasks * TASK_COLS;
+            task(a, b, c, i, std::min(a.getRows(), i + TASK_ROWS), j, std::min(b.getCols(), j + TASK_COLS), packed);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; i++)
+    {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& t : pool)
+    {
+        t.join();
+    }
+}
+
+ensiie::QuaternionMatrix ensiie::operator*(const QuaternionMatrix& a, const QuaternionMatrix& b)
+{
+    QuaternionMatrix c(a.getRows(), b.getCols());
+    gemm(a, b, c);
+    return c;
+}
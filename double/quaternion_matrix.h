@@ -0,0 +1,144 @@
+/**
+ * @file quaternion_matrix.h
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Provides a class for matrices of quaternions and their product.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef QUATERNION_MATRIX_H
+#define QUATERNION_MATRIX_H
+
+#include "quaternion.h"
+#include <cstddef>
+#include <vector>
+
+namespace ensiie
+{
+    /**
+     * @brief A dense matrix of quaternions.
+     *
+     * The components are stored in four separate row-major planes (all t, then all u, all v and all w),
+     * so that the products can be computed on contiguous rows of doubles.
+     */
+    class QuaternionMatrix
+    {
+    private:
+        std::size_t rows, cols;
+        std::vector<double> planes[4];
+
+    public:
+        /**
+         * @brief Construct an empty matrix.
+         *
+         */
+        QuaternionMatrix();
+        /**
+         * @brief Construct a null matrix.
+         *
+         * @param rows Number of rows.
+         * @param cols Number of columns.
+         */
+        QuaternionMatrix(std::size_t rows, std::size_t cols);
+        /**
+         * @brief Destroy the QuaternionMatrix object.
+         *
+         */
+        ~QuaternionMatrix();
+
+        /**
+         * @brief Get the number of rows.
+         *
+         * @return std::size_t Number of rows.
+         */
+        std::size_t getRows() const { return rows; };
+
+        /**
+         * @brief Get the number of columns.
+         *
+         * @return std::size_t Number of columns.
+         */
+        std::size_t getCols() const { return cols; };
+
+        /**
+         * @brief Gets a coefficient.
+         *
+         * @param i Row.
+         * @param j Column.
+         * @return Quaternion Coefficient.
+         */
+        Quaternion get(std::size_t i, std::size_t j) const;
+
+        /**
+         * @brief Sets a coefficient.
+         *
+         * @param i Row.
+         * @param j Column.
+         * @param q Coefficient.
+         */
+        void set(std::size_t i, std::size_t j, const Quaternion& q);
+
+        /**
+         * @brief Gets a plane of components.
+         *
+         * @param k 0 for t, 1 for u, 2 for v, 3 for w.
+         * @return double* Row-major components.
+         */
+        double* plane(int k) { return planes[k].data(); };
+
+        /**
+         * @brief Gets a plane of components.
+         *
+         * @param k 0 for t, 1 for u, 2 for v, 3 for w.
+         * @return const double* Row-major components.
+         */
+        const double* plane(int k) const { return planes[k].data(); };
+
+        /**
+         * @brief Adds two matrices.
+         * @throws std::invalid_argument If the dimensions differ.
+         * @param m Other matrix.
+         * @return QuaternionMatrix&
+         */
+        QuaternionMatrix& operator+=(const QuaternionMatrix& m);
+
+        /**
+         * @brief Equality operator.
+         *
+         * @param m Other matrix.
+         * @return true Matrices are equal.
+         * @return false Matrices are not equal.
+         */
+        bool operator==(const QuaternionMatrix& m) const;
+    };
+
+    /**
+     * @brief Accumulates a matrix product: c += a * b, that is c(i, j) += sum over k of a(i, k) * b(k, j).
+     *
+     * The quaternion product not being commutative, the order of the factors is kept: a right
+     * multiplication x * w is gemm(x, w, y) and a left multiplication w * x is gemm(w, x, y).
+     * The product is tiled for the caches, blocks of 2 rows of c being kept in registers over the depth of a
+     * tile. Blocks of rows and columns of c are shared between threads, the smallest products running on the
+     * calling thread.
+     * @throws std::invalid_argument If the dimensions are not compatible.
+     * @param a Left factor.
+     * @param b Right factor.
+     * @param c Result, distinct from a and b.
+     * @param threads Number of threads, 0 for the number of cores.
+     */
+    void gemm(const QuaternionMatrix& a, const QuaternionMatrix& b, QuaternionMatrix& c, unsigned threads = 0);
+
+    /**
+     * @brief Multiplies two matrices.
+     * @throws std::invalid_argument If the dimensions are not compatible.
+     * @param a Left factor.
+     * @param b Right factor.
+     * @return QuaternionMatrix Product a * b.
+     */
+    QuaternionMatrix operator*(const QuaternionMatrix& a, const QuaternionMatrix& b);
+}
+
+#endif // QUATERNION_MATRIX_H
@@ -0,0 +1,60 @@
+/**
+ * @file quaternion_parallel.h
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Internal helper sharing loops between threads, for the implementation files only.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef QUATERNION_PARALLEL_H
+#define QUATERNION_PARALLEL_H
+
+#include "quaternion_stats.h"
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace ensiie
+{
+    namespace detail
+    {
+        /**
+         * @brief Calls body(first, last) on contiguous ranges of [0, tasks), one per thread.
+         *
+         * The first range runs on the calling thread, and no more threads than tasks are started.
+         * @param tasks Number of tasks.
+         * @param threads Number of threads, at least 1.
+         * @param body Function of a range of tasks, called concurrently.
+         */
+        template <typename Body>
+        void parallel(std::size_t tasks, unsigned threads, const Body& body)
+        {
+            threads = static_cast<unsigned>(std::min<std::size_t>(threads, tasks));
+            if (threads <= 1)
+            {
+                body(0, tasks);
+                return;
+            }
+            std::vector<std::thread> pool;
+            for (unsigned t = 1; t < threads; t++)
+            {
+                pool.emplace_back([&, t] {
+                    // The operations of the workers are internal to the kernel which started them.
+                    QUATERNION_UNCOUNTED();
+                    body(tasks * t / threads, tasks * (t + 1) / threads);
+                });
+            }
+            body(0, tasks / threads);
+            for (std::thread& t : pool)
+            {
+                t.join();
+            }
+        }
+    }
+}
+
+#endif // QUATERNION_PARALLEL_H
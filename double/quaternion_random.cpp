@@ -0,0 +1,288 @@
+/**
+ * @file quaternion_random.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Implements {@link quaternion_random.h}.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "quaternion_random.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr double TWO_PI = 6.28318530717958623200e+00;
+
+    /**
+     * @brief Draws staged at a time, generated as planes of Philox words then as planes of components, so that
+     * both loops are vectorized.
+     *
+     */
+    constexpr std::size_t BLOCK = 256;
+
+    /**
+     * @brief Philox4x32-10 (Salmon et al., 2011): 10 rounds of multiplications and xors of the counter,
+     * keyed by the seed. Each draw only depends on its counter, so draws need no state shared between calls.
+     *
+     */
+    inline void philox(std::uint32_t& c0, std::uint32_t& c1, std::uint32_t& c2, std::uint32_t& c3, std::uint64_t seed)
+    {
+        std::uint32_t k0 = static_cast<std::uint32_t>(seed);
+        std::uint32_t k1 = static_cast<std::uint32_t>(seed >> 32);
+        for (int r = 0; r < 10; r++)
+        {
+            std::uint64_t p0 = std::uint64_t(0xD2511F53) * c0;
+            std::uint64_t p1 = std::uint64_t(0xCD9E8D57) * c2;
+            std::uint32_t x0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+            std::uint32_t x2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+            c0 = x0;
+            c1 = static_cast<std::uint32_t>(p1);
+            c2 = x2;
+            c3 = static_cast<std::uint32_t>(p0);
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+    }
+
+    /**
+     * @brief Planes of the 4 words of Philox blocks.
+     *
+     */
+    struct Words
+    {
+        std::uint32_t w0[BLOCK], w1[BLOCK], w2[BLOCK], w3[BLOCK];
+    };
+
+    /**
+     * @brief Block j of the counters first .. first + count - 1, that is Philox of (k, k >> 32, j, 0) for each k.
+     *
+     */
+    void philoxBlocks(std::uint64_t seed, std::uint64_t first, std::uint32_t j, Words& words, std::size_t count)
+    {
+        std::uint32_t* __restrict w0 = words.w0;
+        std::uint32_t* __restrict w1 = words.w1;
+        std::uint32_t* __restrict w2 = words.w2;
+        std::uint32_t* __restrict w3 = words.w3;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            std::uint64_t k = first + i;
+            std::uint32_t c0 = static_cast<std::uint32_t>(k), c1 = static_cast<std::uint32_t>(k >> 32), c2 = j, c3 = 0;
+            philox(c0, c1, c2, c3, seed);
+            w0[i] = c0;
+            w1[i] = c1;
+            w2[i] = c2;
+            w3[i] = c3;
+        }
+    }
+
+    /**
+     * @brief Uniform number in [0, 1) with the 32 bits of a word. Through a signed conversion, which is
+     * vectorized, unlike the unsigned one.
+     *
+     */
+    inline double uniform32(std::uint32_t w)
+    {
+        return (static_cast<double>(static_cast<std::int32_t>(w ^ 0x80000000u)) + 0x1p31) * 0x1p-32;
+    }
+
+    /**
+     * @brief Uniform number in [0, 1) with the 53 high bits of the word pair (lo, hi), exactly (lo | hi << 32) >> 11
+     * times 2^-53.
+     *
+     */
+    inline double uniform53(std::uint32_t lo, std::uint32_t hi)
+    {
+        return uniform32(hi) + static_cast<double>(static_cast<std::int32_t>(lo >> 11)) * 0x1p-53;
+    }
+
+    /**
+     * @brief Sine and cosine of an angle in [0, 2 pi), always in the domain of the approximations, or <cmath> for Exact.
+     *
+     */
+    template <ensiie::Accuracy A>
+    inline void sincosAngle(double x, double& s, double& c)
+    {
+        if constexpr (A == ensiie::Accuracy::Exact)
+        {
+            ensiie::math::sincos<A>(x, s, c);
+        }
+        else
+        {
+            ensiie::math::sincosUnchecked<A>(x, s, c);
+        }
+    }
+
+    /**
+     * @brief Planes of the components of a block of rotations.
+     *
+     */
+    struct Planes
+    {
+        double t[BLOCK], u[BLOCK], v[BLOCK], w[BLOCK];
+    };
+
+    /**
+     * @brief Shoemake, Uniform random rotations, Graphics Gems III, from one Philox block per draw: 53 bits for the
+     * radii and 32 bits for each angle, a resolution of 1.5e-9 radians, below the error of Fast.
+     *
+     */
+    template <ensiie::Accuracy A>
+    void shoemake(const Words& words, Planes& q, std::size_t count)
+    {
+        const std::uint32_t* __restrict w0 = words.w0;
+        const std::uint32_t* __restrict w1 = words.w1;
+        const std::uint32_t* __restrict w2 = words.w2;
+        const std::uint32_t* __restrict w3 = words.w3;
+        double* __restrict qt = q.t;
+        double* __restrict qu = q.u;
+        double* __restrict qv = q.v;
+        double* __restrict qw = q.w;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            double u0 = uniform53(w0[i], w1[i]);
+            double r1 = std::sqrt(1 - u0);
+            double r2 = std::sqrt(u0);
+            double s1, c1, s2, c2;
+            sincosAngle<A>(TWO_PI * uniform32(w2[i]), s1, c1);
+            sincosAngle<A>(TWO_PI * uniform32(w3[i]), s2, c2);
+            qt[i] = r2 * c2;
+            qu[i] = r1 * s1;
+            qv[i] = r1 * c1;
+            qw[i] = r2 * s2;
+        }
+    }
+
+    template <ensiie::Accuracy A>
+    void uniform(std::uint64_t seed, std::uint64_t first, ensiie::Quaternion* out, std::size_t n)
+    {
+        Words words;
+        Planes q;
+        for (std::size_t start = 0; start < n; start += BLOCK)
+        {
+            std::size_t count = n - start < BLOCK ? n - start : BLOCK;
+            philoxBlocks(seed, first + start, 0, words, count);
+            shoemake<A>(words, q, count);
+            for (std::size_t i = 0; i < count; i++)
+            {
+                out[start + i] = ensiie::Quaternion(q.t[i], q.u[i], q.v[i], q.w[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Rotation vectors of normal coordinates by Box-Muller, with 1 - u in (0, 1] so that the logarithm is
+     * finite. The 2 radii take 53 bits each, so that the tails are not truncated, and the 2 angles 32 bits: 170 bits,
+     * hence 2 Philox blocks per draw. Separate from rotations() as <cmath> log is not vectorized.
+     *
+     * @return double Largest norm of the vectors.
+     */
+    double boxMuller(const Words& first, const Words& second, double sigma, Planes& v, std::size_t count)
+    {
+        double largest = 0;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            double ra = sigma * std::sqrt(-2 * std::log(1 - uniform53(first.w0[i], first.w1[i])));
+            double rb = sigma * std::sqrt(-2 * std::log(1 - uniform53(second.w0[i], second.w1[i])));
+            // The planes hold the radii and the angles until rotations().
+            v.t[i] = ra;
+            v.u[i] = TWO_PI * uniform32(first.w2[i]);
+            v.v[i] = rb;
+            v.w[i] = TWO_PI * uniform32(second.w2[i]);
+            largest = std::max(largest, std::sqrt(ra * ra + rb * rb));
+        }
+        return largest;
+    }
+
+    /**
+     * @brief mean * exp(v / 2) for the radii and angles of boxMuller(), in place.
+     *
+     */
+    template <ensiie::Accuracy A>
+    void rotations(const ensiie::Quaternion& mean, Planes& q, std::size_t count)
+    {
+        const double mt = mean.getT(), mu = mean.getU(), mv = mean.getV(), mw = mean.getW();
+        double* __restrict qt = q.t;
+        double* __restrict qu = q.u;
+        double* __restrict qv = q.v;
+        double* __restrict qw = q.w;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            double sa, ca, sb, cb;
+            sincosAngle<A>(qu[i], sa, ca);
+            sincosAngle<A>(qw[i], sb, cb);
+            double x = qt[i] * ca, y = qt[i] * sa, z = qv[i] * cb;
+            // exp(v / 2) = cos(|v| / 2) + sin(|v| / 2) v / |v|. The offset avoids a division by 0 without a
+            // selection, x, y and z being 0 then.
+            double angle = std::sqrt(x * x + y * y + z * z);
+            double s, c;
+            sincosAngle<A>(angle / 2, s, c);
+            double k = s / (angle + 1e-300);
+            x *= k;
+            y *= k;
+            z *= k;
+            // Product by the mean, as Quaternion::operator*=.
+            qt[i] = mt * c - mu * x - mv * y - mw * z;
+            qu[i] = mt * x + mu * c + mv * z - mw * y;
+            qv[i] = mt * y - mu * z + mv * c + mw * x;
+            qw[i] = mt * z + mu * y - mv * x + mw * c;
+        }
+    }
+
+    template <ensiie::Accuracy A>
+    void perturbed(const ensiie::Quaternion& mean, double sigma, std::uint64_t seed, std::uint64_t first,
+                   ensiie::Quaternion* out, std::size_t n)
+    {
+        Words words[2];
+        Planes q;
+        for (std::size_t start = 0; start < n; start += BLOCK)
+        {
+            std::size_t count = n - start < BLOCK ? n - start : BLOCK;
+            philoxBlocks(seed, first + start, 0, words[0], count);
+            philoxBlocks(seed, first + start, 1, words[1], count);
+            // |v| / 2 is checked once per block rather than in the loop.
+            if (boxMuller(words[0], words[1], sigma, q, count) / 2 < ensiie::math::SINCOS_DOMAIN)
+            {
+                rotations<A>(mean, q, count);
+            }
+            else
+            {
+                rotations<ensiie::Accuracy::Exact>(mean, q, count);
+            }
+            for (std::size_t i = 0; i < count; i++)
+            {
+                out[start + i] = ensiie::Quaternion(q.t[i], q.u[i], q.v[i], q.w[i]);
+            }
+        }
+    }
+}
+
+void ensiie::uniformRotations(std::uint64_t seed, std::uint64_t first, Quaternion* out, std::size_t n, Accuracy accuracy)
+{
+    switch (accuracy)
+    {
+    case Accuracy::Ulp:
+        return uniform<Accuracy::Ulp>(seed, first, out, n);
+    case Accuracy::Fast:
+        return uniform<Accuracy::Fast>(seed, first, out, n);
+    default:
+        return uniform<Accuracy::Exact>(seed, first, out, n);
+    }
+}
+
+void ensiie::perturbedRotations(const Quaternion& mean, double sigma, std::uint64_t seed, std::uint64_t first,
+                                Quaternion* out, std::size_t n, Accuracy accuracy)
+{
+    switch (accuracy)
+    {
+    case Accuracy::Ulp:
+        return perturbed<Accuracy::Ulp>(mean, sigma, seed, first, out, n);
+    case Accuracy::Fast:
+        return perturbed<Accuracy::Fast>(mean, sigma, seed, first, out, n);
+    default:
+        return perturbed<Accuracy::Exact>(mean, sigma, seed, first, out, n);
+    }
+}
@@ -0,0 +1,53 @@
+/**
+ * @file quaternion_random.h
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Provides batch generators of random rotations.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * Draws come from the counter-based generator Philox4x32-10: draw number k of a seed only depends on
+ * (seed, k). A batch starting at draw @p first therefore gives the same rotations however the sequence
+ * is split between threads, and there is no generator state to share or to copy.
+ *
+ */
+
+#ifndef QUATERNION_RANDOM_H
+#define QUATERNION_RANDOM_H
+
+#include "quaternion.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace ensiie
+{
+    /**
+     * @brief Generates rotations uniformly distributed over SO(3), with Shoemake's method.
+     *
+     * @param seed Seed of the sequence.
+     * @param first Index in the sequence of the first draw.
+     * @param out Unit quaternions, out[i] being draw first + i.
+     * @param n Number of rotations.
+     * @param accuracy Accuracy of the trigonometric functions.
+     */
+    void uniformRotations(std::uint64_t seed, std::uint64_t first, Quaternion* out, std::size_t n,
+                          Accuracy accuracy = Accuracy::Exact);
+
+    /**
+     * @brief Generates random rotations around a mean rotation: mean * exp(v / 2), where the rotation
+     * vector v has independent normal coordinates.
+     *
+     * @param mean Mean rotation, a unit quaternion.
+     * @param sigma Standard deviation of each coordinate of the rotation vector, in radians.
+     * @param seed Seed of the sequence.
+     * @param first Index in the sequence of the first draw.
+     * @param out Unit quaternions, out[i] being draw first + i.
+     * @param n Number of rotations.
+     * @param accuracy Accuracy of the trigonometric functions.
+     */
+    void perturbedRotations(const Quaternion& mean, double sigma, std::uint64_t seed, std::uint64_t first,
+                            Quaternion* out, std::size_t n, Accuracy accuracy = Accuracy::Exact);
+}
+
+#endif // QUATERNION_RANDOM_H
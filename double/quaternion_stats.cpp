@@ -0,0 +1,219 @@
+/**
+ * @file quaternion_stats.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Implements {@link quaternion_stats.h}.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "quaternion_stats.h"
+#include <stdexcept>
+
+#ifdef QUATERNION_STATS
+#include <algorithm>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace
+{
+    const char* const OPERATIONS[] = {"add", "subtract", "multiply", "divide", "scalar_multiply", "scalar_divide",
+                                      "inverse", "normalize", "exp", "log", "slerp"};
+    const char* const FAULTS[] = {"division_by_zero", "logarithm_of_zero", "null_rotation_axis", "domain"};
+    const char* const KERNELS[] = {"multiply", "rotate", "normalize", "slerp", "to_matrix", "from_matrix",
+                                   "from_axis_angle", "random_uniform", "random_perturbed", "convert_layout",
+                                   "gemm", "fourier", "point_cloud", "mekf", "cluster"};
+
+    static_assert(sizeof(OPERATIONS) / sizeof(*OPERATIONS) == static_cast<int>(ensiie::stats::Operation::Count));
+    static_assert(sizeof(FAULTS) / sizeof(*FAULTS) == static_cast<int>(ensiie::stats::Fault::Count));
+    static_assert(sizeof(KERNELS) / sizeof(*KERNELS) == static_cast<int>(ensiie::stats::Kernel::Count));
+
+#ifdef QUATERNION_STATS
+    using ensiie::stats::HISTOGRAM_BUCKETS;
+    using ensiie::stats::Snapshot;
+    using ensiie::stats::detail::Counters;
+
+    constexpr int OPERATION_COUNT = static_cast<int>(ensiie::stats::Operation::Count);
+    constexpr int FAULT_COUNT = static_cast<int>(ensiie::stats::Fault::Count);
+    constexpr int KERNEL_COUNT = static_cast<int>(ensiie::stats::Kernel::Count);
+
+    /**
+     * @brief Live counters, the totals of the exited threads and the totals at the last reset.
+     *
+     */
+    struct Registry
+    {
+        std::mutex mutex;
+        std::vector<const Counters*> live;
+        Snapshot retired;
+        Snapshot baseline;
+    };
+
+    Registry& registry()
+    {
+        // Never destroyed, so that threads exiting after main still find it.
+        static Registry* r = new Registry();
+        return *r;
+    }
+
+    void accumulate(Snapshot& s, const Counters& c)
+    {
+        for (int i = 0; i < OPERATION_COUNT; i++)
+        {
+            s.operations[i] += c.operations[i].load(std::memory_order_relaxed);
+        }
+        for (int i = 0; i < FAULT_COUNT; i++)
+        {
+            s.faults[i] += c.faults[i].load(std::memory_order_relaxed);
+        }
+        for (int i = 0; i < KERNEL_COUNT; i++)
+        {
+            ensiie::stats::KernelStats& k = s.kernels[i];
+            k.calls += c.kernels[i].calls.load(std::memory_order_relaxed);
+            k.elements += c.kernels[i].elements.load(std::memory_order_relaxed);
+            k.sampledCalls += c.kernels[i].sampledCalls.load(std::memory_order_relaxed);
+            k.sampledElements += c.kernels[i].sampledElements.load(std::memory_order_relaxed);
+            k.sampledNanoseconds += c.kernels[i].sampledNanoseconds.load(std::memory_order_relaxed);
+            for (std::size_t b = 0; b < HISTOGRAM_BUCKETS; b++)
+            {
+                k.histogram[b] += c.kernels[i].histogram[b].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Sum of all the counters, without the baseline. The mutex of the registry must be held.
+     *
+     */
+    Snapshot total(const Registry& r)
+    {
+        Snapshot s = r.retired;
+        for (const Counters* c : r.live)
+        {
+            accumulate(s, *c);
+        }
+        return s;
+    }
+#endif
+}
+
+#ifdef QUATERNION_STATS
+std::atomic<std::uint32_t> ensiie::stats::detail::period(64);
+
+ensiie::stats::detail::Counters::Counters()
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.live.push_back(this);
+}
+
+ensiie::stats::detail::Counters::~Counters()
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    accumulate(r.retired, *this);
+    r.live.erase(std::find(r.live.begin(), r.live.end(), this));
+}
+
+bool ensiie::stats::enabled()
+{
+    return true;
+}
+
+ensiie::stats::Snapshot ensiie::stats::snapshot()
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Snapshot s = total(r);
+    const Snapshot& b = r.baseline;
+    for (int i = 0; i < OPERATION_COUNT; i++)
+    {
+        s.operations[i] -= b.operations[i];
+    }
+    for (int i = 0; i < FAULT_COUNT; i++)
+    {
+        s.faults[i] -= b.faults[i];
+    }
+    for (int i = 0; i < KERNEL_COUNT; i++)
+    {
+        KernelStats& k = s.kernels[i];
+        k.calls -= b.kernels[i].calls;
+        k.elements -= b.kernels[i].elements;
+        k.sampledCalls -= b.kernels[i].sampledCalls;
+        k.sampledElements -= b.kernels[i].sampledElements;
+        k.sampledNanoseconds -= b.kernels[i].sampledNanoseconds;
+        for (std::size_t j = 0; j < HISTOGRAM_BUCKETS; j++)
+        {
+            k.histogram[j] -= b.kernels[i].histogram[j];
+        }
+    }
+    return s;
+}
+
+void ensiie::stats::reset()
+{
+    // The counters belong to their threads: the current totals become the origin instead.
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.baseline = total(r);
+}
+
+void ensiie::stats::setSamplingPeriod(std::uint32_t period)
+{
+    if (period == 0)
+    {
+        throw std::invalid_argument("Null sampling period");
+    }
+    detail::period.store(period, std::memory_order_relaxed);
+}
+
+std::uint32_t ensiie::stats::samplingPeriod()
+{
+    return detail::period.load(std::memory_order_relaxed);
+}
+#else
+bool ensiie::stats::enabled()
+{
+    return false;
+}
+
+ensiie::stats::Snapshot ensiie::stats::snapshot()
+{
+    return Snapshot();
+}
+
+void ensiie::stats::reset()
+{
+}
+
+void ensiie::stats::setSamplingPeriod(std::uint32_t period)
+{
+    if (period == 0)
+    {
+        throw std::invalid_argument("Null sampling period");
+    }
+}
+
+std::uint32_t ensiie::stats::samplingPeriod()
+{
+    return 0;
+}
+#endif
+
+const char* ensiie::stats::name(Operation operation)
+{
+    return OPERATIONS[static_cast<int>(operation)];
+}
+
+const char* ensiie::stats::name(Fault fault)
+{
+    return FAULTS[static_cast<int>(fault)];
+}
+
+const char* ensiie::stats::name(Kernel kernel)
+{
+    return KERNELS[static_cast<int>(kernel)];
+}
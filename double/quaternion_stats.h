@@ -0,0 +1,327 @@
+/**
+ * @file quaternion_stats.h
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Provides opt-in counters of the operations, faults and batch kernels of the library.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * The library is instrumented when it is built with QUATERNION_STATS defined (make STATS=TRUE). Otherwise, the
+ * instrumentation macros expand to nothing and snapshot() only returns zeros.
+ *
+ * Each thread counts in its own block, without locks nor atomic read-modify-write, and the blocks are summed by
+ * snapshot(). Batch kernels count their calls and elements; one call in samplingPeriod() is also timed, into a
+ * histogram of latencies and a throughput. The scalar operations which the kernels, their worker threads and the
+ * other operations use internally are not counted, so that each operation counts the calls of the caller only.
+ *
+ */
+
+#ifndef QUATERNION_STATS_H
+#define QUATERNION_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef QUATERNION_STATS
+#include <atomic>
+#include <chrono>
+#endif
+
+namespace ensiie
+{
+    namespace stats
+    {
+        /**
+         * @brief Counted scalar operations.
+         *
+         */
+        enum class Operation
+        {
+            Add,
+            Subtract,
+            Multiply,
+            Divide,
+            ScalarMultiply,
+            ScalarDivide,
+            Inverse,
+            Normalize,
+            Exp,
+            Log,
+            Slerp,
+            Count
+        };
+
+        /**
+         * @brief Counted faults: exceptions thrown by the scalar operations, QUAT_EDOMAIN returned by the C interface.
+         *
+         */
+        enum class Fault
+        {
+            DivisionByZero,
+            LogarithmOfZero,
+            NullRotationAxis,
+            Domain,
+            Count
+        };
+
+        /**
+         * @brief Counted and timed batch kernels.
+         *
+         */
+        enum class Kernel
+        {
+            Multiply,
+            Rotate,
+            Normalize,
+            Slerp,
+            ToMatrix,
+            FromMatrix,
+            FromAxisAngle,
+            RandomUniform,
+            RandomPerturbed,
+            ConvertLayout,
+            Gemm,
+            Fourier,
+            PointCloud,
+            Mekf,
+            Cluster,
+            Count
+        };
+
+        /**
+         * @brief Number of buckets of the latency histograms: bucket k counts the latencies in [2^k, 2^(k + 1)) ns.
+         *
+         */
+        constexpr std::size_t HISTOGRAM_BUCKETS = 40;
+
+        /**
+         * @brief Statistics of a batch kernel.
+         *
+         */
+        struct KernelStats
+        {
+            std::uint64_t calls = 0;
+            std::uint64_t elements = 0;
+            std::uint64_t sampledCalls = 0;
+            std::uint64_t sampledElements = 0;
+            std::uint64_t sampledNanoseconds = 0;
+            std::uint64_t histogram[HISTOGRAM_BUCKETS] = {};
+
+            /**
+             * @brief Throughput of the sampled calls.
+             *
+             * @return double Elements per second, 0 without samples.
+             */
+            double throughput() const { return sampledNanoseconds ? 1e9 * sampledElements / sampledNanoseconds : 0; };
+        };
+
+        /**
+         * @brief Statistics of all the threads since the last reset.
+         *
+         */
+        struct Snapshot
+        {
+            std::uint64_t operations[static_cast<int>(Operation::Count)] = {};
+            std::uint64_t faults[static_cast<int>(Fault::Count)] = {};
+            KernelStats kernels[static_cast<int>(Kernel::Count)];
+        };
+
+        /**
+         * @brief Whether the library was built with the instrumentation.
+         *
+         */
+        bool enabled();
+
+        /**
+         * @brief Sums the counters of all the threads, including the threads which have exited.
+         *
+         * @return Snapshot Statistics since the last reset.
+         */
+        Snapshot snapshot();
+
+        /**
+         * @brief Restarts the statistics from zero, for all the threads.
+         *
+         */
+        void reset();
+
+        /**
+         * @brief Sets how often the batch kernels are timed.
+         * @throws std::invalid_argument If period is 0.
+         * @param period One call in period is timed, 1 to time every call.
+         */
+        void setSamplingPeriod(std::uint32_t period);
+
+        /**
+         * @brief Gets how often the batch kernels are timed.
+         *
+         * @return std::uint32_t One call in period is timed, 0 if the library is not instrumented.
+         */
+        std::uint32_t samplingPeriod();
+
+        /**
+         * @brief Name of an operation, for exports.
+         *
+         */
+        const char* name(Operation operation);
+
+        /**
+         * @brief Name of a fault, for exports.
+         *
+         */
+        const char* name(Fault fault);
+
+        /**
+         * @brief Name of a kernel, for exports.
+         *
+         */
+        const char* name(Kernel kernel);
+
+#ifdef QUATERNION_STATS
+        namespace detail
+        {
+            /**
+             * @brief Counters of a thread. Only the owner thread writes them, relaxed atomics let snapshot() read them.
+             *
+             */
+            struct Counters
+            {
+                std::atomic<std::uint64_t> operations[static_cast<int>(Operation::Count)] = {};
+                std::atomic<std::uint64_t> faults[static_cast<int>(Fault::Count)] = {};
+                struct
+                {
+                    std::atomic<std::uint64_t> calls, elements, sampledCalls, sampledElements, sampledNanoseconds;
+                    std::atomic<std::uint64_t> histogram[HISTOGRAM_BUCKETS];
+                } kernels[static_cast<int>(Kernel::Count)] = {};
+                // Depth of the uncounted scopes of the thread, only read by the thread.
+                std::uint32_t uncounted = 0;
+
+                Counters();
+                ~Counters();
+            };
+
+            extern std::atomic<std::uint32_t> period;
+
+            inline Counters& local()
+            {
+                static thread_local Counters counters;
+                return counters;
+            }
+
+            inline void add(std::atomic<std::uint64_t>& counter, std::uint64_t n = 1)
+            {
+                counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+            }
+
+            inline void count(Operation operation)
+            {
+                Counters& c = local();
+                if (c.uncounted == 0)
+                {
+                    add(c.operations[static_cast<int>(operation)]);
+                }
+            }
+
+            /**
+             * @brief Scope in which the scalar operations of the thread are internal, and not counted.
+             *
+             */
+            class Uncounted
+            {
+            public:
+                Uncounted() { local().uncounted++; }
+                ~Uncounted() { local().uncounted--; }
+
+                Uncounted(const Uncounted&) = delete;
+                Uncounted& operator=(const Uncounted&) = delete;
+            };
+
+            /**
+             * @brief Counts a call of a batch kernel, and times it if it is sampled. The scalar operations of the
+             * kernel are not counted.
+             *
+             */
+            class KernelScope
+            {
+            private:
+                Uncounted uncounted;
+                int kernel;
+                std::uint64_t elements;
+                bool sampled;
+                std::chrono::steady_clock::time_point start;
+
+            public:
+                KernelScope(Kernel k, std::size_t n) : kernel(static_cast<int>(k)), elements(n)
+                {
+                    auto& c = local().kernels[kernel];
+                    std::uint64_t calls = c.calls.load(std::memory_order_relaxed);
+                    c.calls.store(calls + 1, std::memory_order_relaxed);
+                    add(c.elements, elements);
+                    sampled = calls % period.load(std::memory_order_relaxed) == 0;
+                    if (sampled)
+                    {
+                        start = std::chrono::steady_clock::now();
+                    }
+                }
+
+                ~KernelScope()
+                {
+                    if (!sampled)
+                    {
+                        return;
+                    }
+                    std::uint64_t ns = static_cast<std::uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+                    auto& c = local().kernels[kernel];
+                    add(c.sampledCalls);
+                    add(c.sampledElements, elements);
+                    add(c.sampledNanoseconds, ns);
+                    std::size_t bucket = 0;
+                    while (ns > 1 && bucket + 1 < HISTOGRAM_BUCKETS)
+                    {
+                        ns >>= 1;
+                        bucket++;
+                    }
+                    add(c.histogram[bucket]);
+                }
+
+                KernelScope(const KernelScope&) = delete;
+                KernelScope& operator=(const KernelScope&) = delete;
+            };
+        }
+#endif
+    }
+}
+
+#ifdef QUATERNION_STATS
+/**
+ * @brief Counts a scalar operation, for instance QUATERNION_COUNT(Multiply).
+ *
+ */
+#define QUATERNION_COUNT(operation) ::ensiie::stats::detail::count(::ensiie::stats::Operation::operation)
+/**
+ * @brief Counts a fault, for instance QUATERNION_FAULT(DivisionByZero).
+ *
+ */
+#define QUATERNION_FAULT(fault) \
+    ::ensiie::stats::detail::add(::ensiie::stats::detail::local().faults[static_cast<int>(::ensiie::stats::Fault::fault)])
+/**
+ * @brief Counts and samples the enclosing scope as a call of a batch kernel on n elements.
+ *
+ */
+#define QUATERNION_KERNEL(kernel, n) \
+    ::ensiie::stats::detail::KernelScope quaternionKernelScope(::ensiie::stats::Kernel::kernel, n)
+/**
+ * @brief Makes the scalar operations of the enclosing scope internal, for instance in the worker threads of a kernel.
+ *
+ */
+#define QUATERNION_UNCOUNTED() ::ensiie::stats::detail::Uncounted quaternionUncountedScope
+#else
+#define QUATERNION_COUNT(operation) ((void)0)
+#define QUATERNION_FAULT(fault) ((void)0)
+#define QUATERNION_KERNEL(kernel, n) ((void)0)
+#define QUATERNION_UNCOUNTED() ((void)0)
+#endif
+
+#endif // QUATERNION_STATS_H
@@ -0,0 +1,93 @@
+/**
+ * @file shared_attitude.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Implements {@link shared_attitude.h}.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "shared_attitude.h"
+
+ensiie::SharedAttitude::SharedAttitude() : SharedAttitude(Attitude{Quaternion::identity()})
+{
+}
+
+ensiie::SharedAttitude::SharedAttitude(const Attitude& a) : latest(0), published(SLOTS - 1)
+{
+    for (Slot& s : slots)
+    {
+        for (std::atomic<double>& w : s.words)
+        {
+            w.store(0, std::memory_order_relaxed);
+        }
+    }
+    // Writes slot 0, which is then published as version 0.
+    publish(a);
+    published = 0;
+    latest.store(0, std::memory_order_release);
+}
+
+void ensiie::SharedAttitude::publish(const Attitude& a)
+{
+    // Publication k goes to slot k % SLOTS, the readers reading publication k - 1 are not disturbed.
+    std::uint64_t k = published + 1;
+    Slot& s = slots[k % SLOTS];
+    std::uint64_t sequence = s.sequence.load(std::memory_order_relaxed);
+    // An odd sequence number marks the slot as being written.
+    s.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    const double words[WORDS] = {a.orientation.getT(), a.orientation.getU(), a.orientation.getV(), a.orientation.getW(),
+                                 a.timestamp, a.angularVelocity[0], a.angularVelocity[1], a.angularVelocity[2]};
+    for (std::size_t i = 0; i < WORDS; i++)
+    {
+        s.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    s.sequence.store(sequence + 2, std::memory_order_release);
+    published = k;
+    latest.store(k, std::memory_order_release);
+}
+
+void ensiie::SharedAttitude::publish(const Quaternion& q)
+{
+    publish(Attitude{q});
+}
+
+bool ensiie::SharedAttitude::tryRead(Attitude& a) const
+{
+    const Slot& s = slots[latest.load(std::memory_order_acquire) % SLOTS];
+    std::uint64_t before = s.sequence.load(std::memory_order_acquire);
+    double words[WORDS];
+    for (std::size_t i = 0; i < WORDS; i++)
+    {
+        words[i] = s.words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    std::uint64_t after = s.sequence.load(std::memory_order_relaxed);
+    if (before != after || (before & 1))
+    {
+        return false;
+    }
+    a.orientation = Quaternion(words[0], words[1], words[2], words[3]);
+    a.timestamp = words[4];
+    a.angularVelocity[0] = words[5];
+    a.angularVelocity[1] = words[6];
+    a.angularVelocity[2] = words[7];
+    return true;
+}
+
+ensiie::Attitude ensiie::SharedAttitude::read() const
+{
+    Attitude a;
+    while (!tryRead(a))
+    {
+    }
+    return a;
+}
+
+std::uint64_t ensiie::SharedAttitude::version() const
+{
+    return latest.load(std::memory_order_acquire);
+}
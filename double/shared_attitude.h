@@ -0,0 +1,133 @@
+/**
+ * @file shared_attitude.h
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Provides a lock-free attitude published by one thread and read by many.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef SHARED_ATTITUDE_H
+#define SHARED_ATTITUDE_H
+
+#include "quaternion.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ensiie
+{
+    /**
+     * @brief An orientation with its time and angular velocity.
+     *
+     */
+    struct Attitude
+    {
+        /**
+         * @brief Orientation.
+         *
+         */
+        Quaternion orientation;
+        /**
+         * @brief Time of the orientation, in the unit of the publisher.
+         *
+         */
+        double timestamp = 0;
+        /**
+         * @brief Angular velocity x, y, z.
+         *
+         */
+        double angularVelocity[3] = {0, 0, 0};
+    };
+
+    /**
+     * @brief An attitude published by a single writer thread and read by any number of reader threads, without locks.
+     *
+     * The attitudes are written in a ring of slots, each guarded by a sequence number (seqlock): the writer never
+     * waits, and a reader copies the latest slot and checks that its sequence number did not change meanwhile.
+     * The readers only contend with the writer on the slot being written, so a read only retries when the writer
+     * has published SLOTS times during one copy. Slots and indices are on their own cache lines, so readers and the
+     * writer do not invalidate each other's lines more than once per publication.
+     */
+    class SharedAttitude
+    {
+    public:
+        /**
+         * @brief Number of slots of the ring.
+         *
+         */
+        static constexpr std::size_t SLOTS = 4;
+
+    private:
+        static constexpr std::size_t WORDS = 8;
+
+        struct alignas(64) Slot
+        {
+            std::atomic<std::uint64_t> sequence{0};
+            std::atomic<double> words[WORDS];
+        };
+
+        Slot slots[SLOTS];
+        alignas(64) std::atomic<std::uint64_t> latest;
+        // Only accessed by the writer.
+        alignas(64) std::uint64_t published;
+
+    public:
+        /**
+         * @brief Construct a SharedAttitude holding a null attitude with the identity orientation.
+         *
+         */
+        SharedAttitude();
+
+        /**
+         * @brief Construct a SharedAttitude holding an attitude.
+         *
+         * @param a Initial attitude.
+         */
+        explicit SharedAttitude(const Attitude& a);
+
+        SharedAttitude(const SharedAttitude&) = delete;
+        SharedAttitude& operator=(const SharedAttitude&) = delete;
+
+        /**
+         * @brief Publishes an attitude. Only one thread may publish.
+         *
+         * @param a Attitude.
+         */
+        void publish(const Attitude& a);
+
+        /**
+         * @brief Publishes an orientation, with a null timestamp and angular velocity. Only one thread may publish.
+         *
+         * @param q Orientation.
+         */
+        void publish(const Quaternion& q);
+
+        /**
+         * @brief Tries once to read the latest attitude.
+         *
+         * @param a Latest attitude, if the read succeeded.
+         * @return true The read is consistent.
+         * @return false The writer overwrote the slot during the copy, a isn't consistent.
+         */
+        bool tryRead(Attitude& a) const;
+
+        /**
+         * @brief Reads the latest attitude, retrying until the copy is consistent.
+         *
+         * @return Attitude Latest attitude.
+         */
+        Attitude read() const;
+
+        /**
+         * @brief Number of publications, which tells readers whether the attitude changed.
+         *
+         * @return std::uint64_t Number of publications since the construction.
+         */
+        std::uint64_t version() const;
+    };
+}
+
+#endif // SHARED_ATTITUDE_H
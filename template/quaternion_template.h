@@ -139,7 +139,7 @@ namespace ensiie
          * @param q Quaternion.
          * @return Quaternion Inverse of q.
          */
-        Quaternion inverse() const { return conjugate() / norm(); };
+        Quaternion inverse() const { return conjugate() / (norm() * norm()); };
 
         /**
          * @brief Gets the inverse of the quaternion.
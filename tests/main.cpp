@@ -0,0 +1,45 @@
+/**
+ * @file main.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Runs the test cases whose name contains the first argument, or all of them.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "test.h"
+#include <cstring>
+#include <exception>
+
+int main(int argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : "";
+    int run = 0, failed = 0;
+    for (const test::Case& c : test::cases())
+    {
+        if (std::strstr(c.name, filter) == nullptr)
+        {
+            continue;
+        }
+        std::printf("%s\n", c.name);
+        test::failures() = 0;
+        try
+        {
+            c.body();
+        }
+        catch (const std::exception& e)
+        {
+            std::fprintf(stderr, "  unexpected exception: %s\n", e.what());
+            test::failures()++;
+        }
+        run++;
+        if (test::failures() > 0)
+        {
+            failed++;
+        }
+    }
+    std::printf("%d cases, %d failed\n", run, failed);
+    return failed == 0 ? 0 : 1;
+}
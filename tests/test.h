@@ -0,0 +1,154 @@
+/**
+ * @file test.h
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Provides a minimal test framework: cases registered by TEST and checked by CHECK macros.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#ifndef TEST_H
+#define TEST_H
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace test
+{
+    /**
+     * @brief A test case.
+     *
+     */
+    struct Case
+    {
+        const char* name;
+        void (*body)();
+    };
+
+    /**
+     * @brief Gets the registered test cases.
+     *
+     * @return std::vector<Case>& Cases, in registration order.
+     */
+    inline std::vector<Case>& cases()
+    {
+        static std::vector<Case> all;
+        return all;
+    }
+
+    /**
+     * @brief Gets the number of failed checks of the running case.
+     *
+     * @return int& Failures.
+     */
+    inline int& failures()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    /**
+     * @brief Records a failed check.
+     *
+     * @param file Source file.
+     * @param line Line.
+     * @param expression Checked expression.
+     */
+    inline void fail(const char* file, int line, const char* expression)
+    {
+        std::fprintf(stderr, "  %s:%d: check failed: %s\n", file, line, expression);
+        failures()++;
+    }
+
+    /**
+     * @brief A fresh temporary directory, removed with its files on destruction.
+     *
+     */
+    class TemporaryDirectory
+    {
+    private:
+        std::filesystem::path path;
+
+    public:
+        explicit TemporaryDirectory(const std::string& name)
+            : path(std::filesystem::temp_directory_path() / ("quaternion_" + name + "_" + std::to_string(::getpid())))
+        {
+            std::filesystem::remove_all(path);
+            std::filesystem::create_directory(path);
+        }
+        ~TemporaryDirectory() { std::filesystem::remove_all(path); }
+        TemporaryDirectory(const TemporaryDirectory&) = delete;
+        TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+        std::string file(const std::string& name) const { return (path / name).string(); }
+    };
+
+    /**
+     * @brief Registers a test case at static initialization.
+     *
+     */
+    struct Registration
+    {
+        Registration(const char* name, void (*body)())
+        {
+            cases().push_back({name, body});
+        }
+    };
+}
+
+/**
+ * @brief Defines and registers a test case.
+ *
+ */
+#define TEST(name)                                                  \
+    static void test_##name();                                      \
+    static test::Registration registration_##name(#name, test_##name); \
+    static void test_##name()
+
+/**
+ * @brief Checks a condition, going on with the case if it fails.
+ *
+ */
+#define CHECK(condition)                                  \
+    do                                                    \
+    {                                                     \
+        if (!(condition))                                 \
+        {                                                 \
+            test::fail(__FILE__, __LINE__, #condition);   \
+        }                                                 \
+    } while (0)
+
+/**
+ * @brief Checks that two values are within a tolerance of each other.
+ *
+ */
+#define CHECK_NEAR(a, b, tolerance) CHECK(std::abs((a) - (b)) <= (tolerance))
+
+/**
+ * @brief Checks that a statement throws an exception of a type.
+ *
+ */
+#define CHECK_THROWS(statement, type)                                      \
+    do                                                                     \
+    {                                                                      \
+        bool thrown = false;                                               \
+        try                                                                \
+        {                                                                  \
+            statement;                                                     \
+        }                                                                  \
+        catch (const type&)                                                \
+        {                                                                  \
+            thrown = true;                                                 \
+        }                                                                  \
+        if (!thrown)                                                       \
+        {                                                                  \
+            test::fail(__FILE__, __LINE__, #statement " throws " #type);   \
+        }                                                                  \
+    } while (0)
+
+#endif // TEST_H
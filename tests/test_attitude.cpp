@@ -0,0 +1,121 @@
+/**
+ * @file test_attitude.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Tests the shared attitude: publications and versions, and reads never torn by a concurrent writer.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "shared_attitude.h"
+#include "test.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using ensiie::Attitude;
+using ensiie::Quaternion;
+using ensiie::SharedAttitude;
+
+namespace
+{
+    /**
+     * @brief Publication k, each of whose words depends on k.
+     *
+     */
+    Attitude publication(std::uint64_t k)
+    {
+        double x = static_cast<double>(k);
+        Attitude a;
+        a.orientation = Quaternion(x, x + 1, x + 2, x + 3);
+        a.timestamp = x + 4;
+        a.angularVelocity[0] = x + 5;
+        a.angularVelocity[1] = x + 6;
+        a.angularVelocity[2] = x + 7;
+        return a;
+    }
+
+    /**
+     * @brief Whether an attitude is a whole publication, and which one.
+     *
+     */
+    bool whole(const Attitude& a, double& k)
+    {
+        k = a.orientation.getT();
+        const Attitude expected = publication(static_cast<std::uint64_t>(k));
+        return a.orientation == expected.orientation && a.timestamp == expected.timestamp &&
+               a.angularVelocity[0] == expected.angularVelocity[0] && a.angularVelocity[1] == expected.angularVelocity[1] &&
+               a.angularVelocity[2] == expected.angularVelocity[2];
+    }
+}
+
+TEST(attitude_publications)
+{
+    SharedAttitude identity;
+    CHECK(identity.read().orientation == Quaternion::identity());
+    CHECK(identity.version() == 0);
+
+    SharedAttitude shared(publication(10));
+    double k;
+    CHECK(whole(shared.read(), k) && k == 10);
+    CHECK(shared.version() == 0);
+    // More publications than slots, each read back.
+    for (std::uint64_t i = 1; i <= 3 * SharedAttitude::SLOTS; i++)
+    {
+        shared.publish(publication(10 + i));
+        CHECK(shared.version() == i);
+        Attitude a;
+        CHECK(shared.tryRead(a) && whole(a, k) && k == static_cast<double>(10 + i));
+    }
+    shared.publish(Quaternion(0, 1, 0, 0));
+    Attitude a = shared.read();
+    CHECK(a.orientation == Quaternion(0, 1, 0, 0) && a.timestamp == 0 && a.angularVelocity[2] == 0);
+}
+
+TEST(attitude_concurrent_reads)
+{
+    const std::uint64_t publications = 200000;
+    SharedAttitude shared(publication(0));
+    std::atomic<bool> done(false);
+    std::atomic<std::uint64_t> torn(0), reads(0);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; r++)
+    {
+        readers.emplace_back([&] {
+            // Reads until the end of the publications, and at least once after it.
+            for (bool last = false; !last;)
+            {
+                last = done.load();
+                Attitude a = shared.read();
+                double k;
+                if (!whole(a, k) || k > static_cast<double>(publications))
+                {
+                    torn++;
+                }
+                reads++;
+            }
+        });
+    }
+    for (std::uint64_t k = 1; k <= publications; k++)
+    {
+        shared.publish(publication(k));
+        if (k % 1000 == 0)
+        {
+            // Lets the readers run on a single core.
+            std::this_thread::yield();
+        }
+    }
+    done.store(true);
+    for (std::thread& t : readers)
+    {
+        t.join();
+    }
+    CHECK(torn.load() == 0);
+    CHECK(reads.load() >= 3);
+    double k;
+    CHECK(whole(shared.read(), k) && k == static_cast<double>(publications));
+    CHECK(shared.version() == publications);
+}
@@ -0,0 +1,203 @@
+/**
+ * @file test_c.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Tests the C interface: strides, broadcasting, aliasing, layouts and error codes.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "quaternion.h"
+#include "quaternion_c.h"
+#include "test.h"
+#include <algorithm>
+
+namespace
+{
+    const double A[3][4] = {{0.5, -0.5, 0.5, 0.5}, {1, 2, 3, 4}, {-0.25, 0.75, 0.1, -2}};
+    const double B[3][4] = {{2, 0, -1, 0.5}, {0.3, -0.2, 0.9, 0.1}, {1, 1, 1, 1}};
+
+    ensiie::Quaternion wxyz(const double* p)
+    {
+        return ensiie::Quaternion(p[0], p[1], p[2], p[3]);
+    }
+
+    bool equal(const double* p, const ensiie::Quaternion& q, double tolerance = 1e-15)
+    {
+        return std::abs(p[0] - q.getT()) <= tolerance && std::abs(p[1] - q.getU()) <= tolerance &&
+               std::abs(p[2] - q.getV()) <= tolerance && std::abs(p[3] - q.getW()) <= tolerance;
+    }
+}
+
+TEST(c_abi_version)
+{
+    CHECK(quat_abi_version() == QUAT_ABI_VERSION);
+}
+
+TEST(c_multiply_in_place)
+{
+    double a[3][4];
+    std::copy(&A[0][0], &A[0][0] + 12, &a[0][0]);
+    CHECK(quat_multiply(3, &a[0][0], 4, &B[0][0], 4, &a[0][0], 4, QUAT_LAYOUT_WXYZ) == QUAT_OK);
+    for (int i = 0; i < 3; i++)
+    {
+        CHECK(equal(a[i], wxyz(A[i]) * wxyz(B[i])));
+    }
+
+    // The right operand aliased by the output.
+    double b[3][4];
+    std::copy(&B[0][0], &B[0][0] + 12, &b[0][0]);
+    CHECK(quat_multiply(3, &A[0][0], 4, &b[0][0], 4, &b[0][0], 4, QUAT_LAYOUT_WXYZ) == QUAT_OK);
+    for (int i = 0; i < 3; i++)
+    {
+        CHECK(equal(b[i], wxyz(A[i]) * wxyz(B[i])));
+    }
+}
+
+TEST(c_multiply_broadcast)
+{
+    double out[3][4];
+    CHECK(quat_multiply(3, &A[0][0], 4, B[1], 0, &out[0][0], 4, QUAT_LAYOUT_WXYZ) == QUAT_OK);
+    for (int i = 0; i < 3; i++)
+    {
+        CHECK(equal(out[i], wxyz(A[i]) * wxyz(B[1])));
+    }
+
+    // Broadcasting an input that the output aliases: the first product overwrites it.
+    double a[4];
+    std::copy(A[0], A[0] + 4, a);
+    CHECK(quat_multiply(1, a, 0, B[0], 0, a, 0, QUAT_LAYOUT_WXYZ) == QUAT_OK);
+    CHECK(equal(a, wxyz(A[0]) * wxyz(B[0])));
+}
+
+TEST(c_negative_and_interleaved_strides)
+{
+    // Records of 5 doubles, read backwards.
+    double records[3][5];
+    for (int i = 0; i < 3; i++)
+    {
+        std::copy(A[i], A[i] + 4, records[i]);
+        records[i][4] = 42;
+    }
+    double out[3][4];
+    CHECK(quat_multiply(3, records[2], -5, &B[0][0], 4, &out[0][0], 4, QUAT_LAYOUT_WXYZ) == QUAT_OK);
+    for (int i = 0; i < 3; i++)
+    {
+        CHECK(equal(out[i], wxyz(A[2 - i]) * wxyz(B[i])));
+    }
+    CHECK(quat_normalize(3, records[0], 5, records[0], 5, QUAT_LAYOUT_WXYZ) == QUAT_OK);
+    for (int i = 0; i < 3; i++)
+    {
+        CHECK(equal(records[i], wxyz(A[i]).normalize()));
+        CHECK(records[i][4] == 42);
+    }
+}
+
+TEST(c_layouts)
+{
+    double xyzw[3][4], out[3][4];
+    CHECK(quat_convert_layout(3, &A[0][0], 4, QUAT_LAYOUT_WXYZ, &xyzw[0][0], 4, QUAT_LAYOUT_XYZW) == QUAT_OK);
+    CHECK(xyzw[1][0] == 2 && xyzw[1][1] == 3 && xyzw[1][2] == 4 && xyzw[1][3] == 1);
+    CHECK(quat_multiply(3, &xyzw[0][0], 4, &xyzw[0][0], 4, &out[0][0], 4, QUAT_LAYOUT_XYZW) == QUAT_OK);
+    CHECK(quat_convert_layout(3, &out[0][0], 4, QUAT_LAYOUT_XYZW, &out[0][0], 4, QUAT_LAYOUT_WXYZ) == QUAT_OK);
+    for (int i = 0; i < 3; i++)
+    {
+        CHECK(equal(out[i], wxyz(A[i]) * wxyz(A[i])));
+    }
+}
+
+TEST(c_rotate)
+{
+    double q[4] = {0.5, 0.5, 0.5, 0.5};
+    double v[2][3] = {{1, 0, 0}, {0.2, -0.7, 1.5}};
+    double expected[2][3];
+    for (int i = 0; i < 2; i++)
+    {
+        double x = v[i][0], y = v[i][1], z = v[i][2];
+        ensiie::Quaternion(0.5, 0.5, 0.5, 0.5).rotate(x, y, z);
+        expected[i][0] = x;
+        expected[i][1] = y;
+        expected[i][2] = z;
+    }
+    // A broadcast rotation applied in place.
+    CHECK(quat_rotate(2, q, 0, &v[0][0], 3, &v[0][0], 3, QUAT_LAYOUT_WXYZ) == QUAT_OK);
+    for (int i = 0; i < 2; i++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            CHECK_NEAR(v[i][k], expected[i][k], 1e-15);
+        }
+    }
+    // x goes to y under a third of a turn around (1, 1, 1).
+    CHECK_NEAR(expected[0][1], 1, 1e-15);
+}
+
+TEST(c_slerp_broadcast)
+{
+    double a[4] = {1, 0, 0, 0};
+    double b[4] = {0, 0, 0, 1};
+    double s[3] = {0, 0.5, 1};
+    double out[3][4];
+    for (int accuracy : {QUAT_ACCURACY_EXACT, QUAT_ACCURACY_ULP, QUAT_ACCURACY_FAST})
+    {
+        CHECK(quat_slerp_ex(3, a, 0, b, 0, s, 1, &out[0][0], 4, QUAT_LAYOUT_WXYZ, accuracy) == QUAT_OK);
+        CHECK(equal(out[0], wxyz(a), 1e-7));
+        CHECK(equal(out[1], ensiie::Quaternion(std::sqrt(0.5), 0, 0, std::sqrt(0.5)), 1e-7));
+        CHECK(equal(out[2], wxyz(b), 1e-7));
+    }
+    // A single parameter for the whole batch, in place.
+    double q[2][4] = {{1, 0, 0, 0}, {0, 1, 0, 0}};
+    double half = 0.5;
+    CHECK(quat_slerp(2, &q[0][0], 4, b, 0, &half, 0, &q[0][0], 4, QUAT_LAYOUT_WXYZ) == QUAT_OK);
+    CHECK(equal(q[0], ensiie::Quaternion::slerp(wxyz(a), wxyz(b), 0.5)));
+    CHECK(equal(q[1], ensiie::Quaternion::slerp(ensiie::Quaternion(0, 1, 0, 0), wxyz(b), 0.5)));
+}
+
+TEST(c_matrices)
+{
+    double q[3][4], m[3][9], back[3][4];
+    CHECK(quat_normalize(3, &A[0][0], 4, &q[0][0], 4, QUAT_LAYOUT_WXYZ) == QUAT_OK);
+    CHECK(quat_to_matrix(3, &q[0][0], 4, &m[0][0], 9, QUAT_LAYOUT_WXYZ) == QUAT_OK);
+    CHECK(quat_from_matrix(3, &m[0][0], 9, &back[0][0], 4, QUAT_LAYOUT_WXYZ) == QUAT_OK);
+    for (int i = 0; i < 3; i++)
+    {
+        // The real part of the result is non-negative.
+        double sign = q[i][0] < 0 ? -1 : 1;
+        CHECK(equal(back[i], wxyz(q[i]) * sign, 1e-15));
+    }
+}
+
+TEST(c_axis_angle)
+{
+    double axis[2][3] = {{0, 0, 2}, {0, 0, 0}};
+    double angle = ensiie::math::PIO2;
+    double q[2][4];
+    CHECK(quat_from_axis_angle(2, &axis[0][0], 3, &angle, 0, &q[0][0], 4, QUAT_LAYOUT_XYZW) == QUAT_EDOMAIN);
+    CHECK_NEAR(q[0][2], std::sqrt(0.5), 1e-15);
+    CHECK_NEAR(q[0][3], std::sqrt(0.5), 1e-15);
+    // The null axis gives the identity.
+    CHECK(q[1][0] == 0 && q[1][1] == 0 && q[1][2] == 0 && q[1][3] == 1);
+}
+
+TEST(c_errors)
+{
+    double out[2][4] = {{7, 7, 7, 7}, {7, 7, 7, 7}};
+    CHECK(quat_multiply(2, nullptr, 4, &B[0][0], 4, &out[0][0], 4, QUAT_LAYOUT_WXYZ) == QUAT_EINVAL);
+    CHECK(quat_multiply(2, &A[0][0], 4, &B[0][0], 4, &out[0][0], 4, 2) == QUAT_EINVAL);
+    // Overlapping outputs.
+    CHECK(quat_multiply(2, &A[0][0], 4, &B[0][0], 4, &out[0][0], 3, QUAT_LAYOUT_WXYZ) == QUAT_EINVAL);
+    CHECK(quat_slerp_ex(2, &A[0][0], 4, &B[0][0], 4, &A[0][0], 0, &out[0][0], 4, QUAT_LAYOUT_WXYZ, 3) == QUAT_EINVAL);
+    for (int i = 0; i < 2; i++)
+    {
+        CHECK(out[i][0] == 7 && out[i][1] == 7 && out[i][2] == 7 && out[i][3] == 7);
+    }
+    // Nothing to do is not an error, with or without buffers.
+    CHECK(quat_multiply(0, &A[0][0], 4, &B[0][0], 4, &out[0][0], 4, QUAT_LAYOUT_WXYZ) == QUAT_OK);
+
+    double q[2][4] = {{0, 0, 0, 0}, {0, 3, 0, 4}};
+    CHECK(quat_normalize(2, &q[0][0], 4, &q[0][0], 4, QUAT_LAYOUT_WXYZ) == QUAT_EDOMAIN);
+    CHECK(q[0][0] == 0 && q[0][1] == 0 && q[0][2] == 0 && q[0][3] == 0);
+    CHECK(equal(q[1], ensiie::Quaternion(0, 0.6, 0, 0.8)));
+}
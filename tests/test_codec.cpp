@@ -0,0 +1,122 @@
+/**
+ * @file test_codec.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Tests the compressed formats: error bounds, canonical signs, ties and the array functions.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "quaternion_codec.h"
+#include "quaternion_random.h"
+#include "test.h"
+#include <algorithm>
+#include <vector>
+
+using ensiie::Packed48;
+using ensiie::Quaternion;
+namespace codec = ensiie::codec;
+
+namespace
+{
+    double angle(const Quaternion& a, const Quaternion& b)
+    {
+        Quaternion c = Quaternion::dot(a, b) < 0 ? -b : b;
+        return 4 * std::atan2((a - c).norm(), (a + c).norm());
+    }
+
+    /**
+     * @brief Uniform rotations, then rotations with ties and null components.
+     *
+     */
+    std::vector<Quaternion> rotations()
+    {
+        std::vector<Quaternion> q(100000);
+        ensiie::uniformRotations(7, 0, q.data(), q.size());
+        const double h = 0.5, s = std::sqrt(0.5);
+        for (Quaternion x : {Quaternion(1, 0, 0, 0), Quaternion(0, 0, 0, -1), Quaternion(h, h, h, h),
+                             Quaternion(-h, h, -h, h), Quaternion(0, s, -s, 0), Quaternion(s, 0, 0, -s),
+                             Quaternion(0.1, -0.7, 0.7, 0.1), Quaternion(3, 4, 0, 0)})
+        {
+            q.push_back(x);
+        }
+        return q;
+    }
+}
+
+TEST(codec_error_bounds)
+{
+    std::vector<Quaternion> q = rotations();
+    std::size_t n = q.size();
+    std::vector<std::uint32_t> p32(n);
+    std::vector<Packed48> p48(n);
+    std::vector<std::uint64_t> p64(n);
+    std::vector<Quaternion> d32(n), d48(n), d64(n);
+    codec::encode32(q.data(), p32.data(), n);
+    codec::encode48(q.data(), p48.data(), n);
+    codec::encode64(q.data(), p64.data(), n);
+    codec::decode32(p32.data(), d32.data(), n);
+    codec::decode48(p48.data(), d48.data(), n);
+    codec::decode64(p64.data(), d64.data(), n);
+    double e32 = 0, e48 = 0, e64 = 0;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        Quaternion unit = q[i].normalize();
+        e32 = std::max(e32, angle(unit, d32[i]));
+        e48 = std::max(e48, angle(unit, d48[i]));
+        e64 = std::max(e64, angle(unit, d64[i]));
+        CHECK_NEAR(d32[i].norm(), 1, 1e-15);
+    }
+    // Bounds of quaternion_codec.h.
+    CHECK(e32 <= 4.2e-3);
+    CHECK(e48 <= 1.4e-4);
+    CHECK(e64 <= 4.3e-6);
+}
+
+TEST(codec_arrays_match_single)
+{
+    std::vector<Quaternion> q = rotations();
+    // Not a multiple of the blocks of the array functions.
+    std::size_t n = 1000;
+    std::vector<std::uint32_t> p32(n);
+    std::vector<Packed48> p48(n);
+    std::vector<std::uint64_t> p64(n);
+    std::vector<Quaternion> d64(n);
+    codec::encode32(q.data(), p32.data(), n);
+    codec::encode48(q.data(), p48.data(), n);
+    codec::encode64(q.data(), p64.data(), n);
+    codec::decode64(p64.data(), d64.data(), n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+        CHECK(p32[i] == codec::encode32(q[i]));
+        Packed48 single = codec::encode48(q[i]);
+        CHECK(p48[i].c[0] == single.c[0] && p48[i].c[1] == single.c[1] && p48[i].c[2] == single.c[2]);
+        CHECK(p64[i] == codec::encode64(q[i]));
+        Quaternion d = codec::decode64(p64[i]);
+        CHECK(d.getT() == d64[i].getT() && d.getU() == d64[i].getU() && d.getV() == d64[i].getV() && d.getW() == d64[i].getW());
+    }
+}
+
+TEST(codec_sign)
+{
+    // q and -q are the same rotation, with the same encoding.
+    for (const Quaternion& q : rotations())
+    {
+        CHECK(codec::encode32(-q) == codec::encode32(q));
+        CHECK(codec::encode64(-q) == codec::encode64(q));
+    }
+}
+
+TEST(codec_ties)
+{
+    // The first largest component is dropped, and made positive.
+    const double h = 0.5;
+    CHECK(codec::encode32(Quaternion(h, h, h, h)) >> 30 == 0);
+    CHECK(codec::encode32(Quaternion(0.1, -h, h, 0.1)) >> 30 == 1);
+    CHECK(codec::encode32(Quaternion(0, 0, 0, -1)) >> 30 == 3);
+    Quaternion d = codec::decode64(codec::encode64(Quaternion(0, 0, 0, -1)));
+    CHECK_NEAR(d.getW(), 1, 1e-12);
+    CHECK(std::abs(d.getT()) < 1e-6 && std::abs(d.getU()) < 1e-6 && std::abs(d.getV()) < 1e-6);
+}
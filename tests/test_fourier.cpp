@@ -0,0 +1,153 @@
+/**
+ * @file test_fourier.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Tests the quaternion Fourier transforms: known transforms and round trips of signals and images, for
+ * radix-2 and Bluestein sizes, each side and several threads.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "quaternion_fourier.h"
+#include "test.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using ensiie::FourierPlan;
+using ensiie::FourierSide;
+using ensiie::Quaternion;
+using ensiie::QuaternionMatrix;
+
+namespace
+{
+    const Quaternion MU(0, 1, 2, 2);
+
+    Quaternion sample(std::size_t i)
+    {
+        double x = static_cast<double>(i);
+        return Quaternion(std::sin(0.7 * x), std::cos(1.3 * x), std::sin(0.2 * x + 1), 0.5 - std::cos(2.9 * x));
+    }
+
+    double error(const std::vector<Quaternion>& a, const std::vector<Quaternion>& b)
+    {
+        double largest = 0;
+        for (std::size_t i = 0; i < a.size(); i++)
+        {
+            largest = std::max(largest, (a[i] - b[i]).norm());
+        }
+        return largest;
+    }
+
+    double error(const QuaternionMatrix& a, const QuaternionMatrix& b)
+    {
+        double largest = 0;
+        for (std::size_t i = 0; i < a.getRows(); i++)
+        {
+            for (std::size_t j = 0; j < a.getCols(); j++)
+            {
+                largest = std::max(largest, (a.get(i, j) - b.get(i, j)).norm());
+            }
+        }
+        return largest;
+    }
+}
+
+TEST(fourier_known_transforms)
+{
+    for (std::size_t n : {1, 8, 12})
+    {
+        for (FourierSide side : {FourierSide::Left, FourierSide::Right})
+        {
+            FourierPlan plan(n, side, MU, 1);
+            // An impulse at 0 has a flat transform, and a constant signal an impulse of n times its value.
+            std::vector<Quaternion> impulse(n), constant(n, sample(1)), out(n);
+            impulse[0] = sample(1);
+            plan.forward(impulse.data(), out.data());
+            CHECK(error(out, constant) < 1e-14);
+            plan.forward(constant.data(), out.data());
+            impulse[0] = sample(1) * static_cast<double>(n);
+            CHECK(error(out, impulse) < 1e-13);
+        }
+    }
+}
+
+TEST(fourier_signal_round_trips)
+{
+    // Powers of 2 use the radix-2 FFT, the other sizes Bluestein's algorithm.
+    for (std::size_t n : {2, 64, 7, 60, 1000})
+    {
+        for (FourierSide side : {FourierSide::Left, FourierSide::Right})
+        {
+            const std::size_t count = 5;
+            std::vector<Quaternion> in(count * n), transform(count * n), out(count * n);
+            for (std::size_t i = 0; i < in.size(); i++)
+            {
+                in[i] = sample(i);
+            }
+            std::vector<Quaternion> single(count * n);
+            FourierPlan(n, side, MU, 1).forward(in.data(), single.data(), count);
+            for (unsigned threads : {1u, 3u})
+            {
+                FourierPlan plan(n, side, MU, threads);
+                plan.forward(in.data(), transform.data(), count);
+                CHECK(transform == single);
+                plan.inverse(transform.data(), out.data(), count);
+                CHECK(error(in, out) < 1e-12);
+                // In place.
+                out = in;
+                plan.forward(out.data(), out.data(), count);
+                plan.inverse(out.data(), out.data(), count);
+                CHECK(error(in, out) < 1e-12);
+            }
+        }
+    }
+}
+
+TEST(fourier_image_round_trips)
+{
+    const std::size_t sizes[][2] = {{1, 1}, {8, 16}, {6, 10}, {5, 32}, {33, 7}};
+    for (const auto& size : sizes)
+    {
+        QuaternionMatrix in(size[0], size[1]), transform(size[0], size[1]), out(size[0], size[1]);
+        for (std::size_t i = 0; i < size[0]; i++)
+        {
+            for (std::size_t j = 0; j < size[1]; j++)
+            {
+                in.set(i, j, sample(i * size[1] + j));
+            }
+        }
+        for (FourierSide side : {FourierSide::Left, FourierSide::Right, FourierSide::TwoSided})
+        {
+            for (unsigned threads : {1u, 4u})
+            {
+                FourierPlan plan(size[0], size[1], side, MU, Quaternion(0, -1, 0, 1), threads);
+                plan.forward(in, transform);
+                plan.inverse(transform, out);
+                CHECK(error(in, out) < 1e-12);
+                out = in;
+                plan.forward(out, out);
+                plan.inverse(out, out);
+                CHECK(error(in, out) < 1e-12);
+            }
+        }
+    }
+}
+
+TEST(fourier_arguments)
+{
+    CHECK_THROWS(FourierPlan(0, FourierSide::Left, MU), std::invalid_argument);
+    CHECK_THROWS(FourierPlan(8, FourierSide::Left, Quaternion(1, 1, 0, 0)), std::invalid_argument);
+    CHECK_THROWS(FourierPlan(8, FourierSide::Left, Quaternion(0, 0, 0, 0)), std::invalid_argument);
+    CHECK_THROWS(FourierPlan(8, FourierSide::TwoSided, MU), std::invalid_argument);
+    CHECK_THROWS(FourierPlan(4, 0, FourierSide::Left, MU, MU), std::invalid_argument);
+    FourierPlan signal(4, FourierSide::Left, MU), image(4, 4, FourierSide::Left, MU, MU);
+    QuaternionMatrix m(4, 4), wrong(4, 5);
+    std::vector<Quaternion> q(4);
+    CHECK_THROWS(signal.forward(m, m), std::invalid_argument);
+    CHECK_THROWS(image.forward(q.data(), q.data()), std::invalid_argument);
+    CHECK_THROWS(image.inverse(wrong, wrong), std::invalid_argument);
+}
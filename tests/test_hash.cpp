@@ -0,0 +1,164 @@
+/**
+ * @file test_hash.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Tests the clustering of rotations against the quadratic greedy clustering, and the hashes of rotations.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "quaternion_hash.h"
+#include "quaternion_random.h"
+#include "test.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using ensiie::Quaternion;
+using ensiie::RotationClusters;
+
+namespace
+{
+    /**
+     * @brief Angle of the rotation between two rotations.
+     *
+     */
+    double angle(const Quaternion& p, const Quaternion& q)
+    {
+        Quaternion a = p / p.norm(), b = q / q.norm();
+        Quaternion c = Quaternion::dot(a, b) < 0 ? -b : b;
+        return 4 * std::atan2((a - c).norm(), (a + c).norm());
+    }
+
+    /**
+     * @brief The definition of clusterRotations(), comparing every rotation with every representative.
+     *
+     */
+    RotationClusters greedy(const std::vector<Quaternion>& q, double tolerance)
+    {
+        RotationClusters clusters;
+        for (std::size_t i = 0; i < q.size(); i++)
+        {
+            bool covered = false;
+            for (std::size_t r : clusters.representatives)
+            {
+                covered = covered || angle(q[i], q[r]) <= tolerance;
+            }
+            if (!covered)
+            {
+                clusters.representatives.push_back(i);
+            }
+        }
+        for (std::size_t i = 0; i < q.size(); i++)
+        {
+            std::size_t best = 0;
+            for (std::size_t k = 1; k < clusters.representatives.size(); k++)
+            {
+                if (angle(q[i], q[clusters.representatives[k]]) < angle(q[i], q[clusters.representatives[best]]))
+                {
+                    best = k;
+                }
+            }
+            clusters.labels.push_back(best);
+        }
+        return clusters;
+    }
+
+    /**
+     * @brief Clouds of rotations around a few random means, interleaved, scaled and with random signs.
+     *
+     */
+    std::vector<Quaternion> clouds(std::size_t means, std::size_t size, double sigma)
+    {
+        std::vector<Quaternion> centers(means), q(means * size), cloud(size);
+        ensiie::uniformRotations(1, 0, centers.data(), means);
+        for (std::size_t m = 0; m < means; m++)
+        {
+            ensiie::perturbedRotations(centers[m], sigma, 2, m * size, cloud.data(), size);
+            for (std::size_t i = 0; i < size; i++)
+            {
+                double scale = (i % 3 == 0 ? -1 : 1) * (0.5 + static_cast<double>(i % 7));
+                q[i * means + m] = cloud[i] * scale;
+            }
+        }
+        return q;
+    }
+}
+
+TEST(hash_cluster_matches_greedy)
+{
+    struct
+    {
+        std::vector<Quaternion> q;
+        double tolerance;
+    } cases[] = {{clouds(8, 600, 0.05), 0.1}, {clouds(1, 300, 0.5), 0.4}, {clouds(2000, 1, 0), 0.5}};
+    for (const auto& c : cases)
+    {
+        RotationClusters expected = greedy(c.q, c.tolerance);
+        // Above 4096 rotations, the representatives are chosen in several blocks.
+        for (unsigned threads : {1u, 3u})
+        {
+            RotationClusters clusters = ensiie::clusterRotations(c.q.data(), c.q.size(), c.tolerance, threads);
+            CHECK(clusters.representatives == expected.representatives);
+            CHECK(clusters.labels == expected.labels);
+        }
+    }
+}
+
+TEST(hash_deduplicate)
+{
+    std::vector<Quaternion> q = {Quaternion(1, 1, 0, 0), Quaternion(-2, -2, 0, 0), Quaternion(1e300, 1e300, 0, 0),
+                                 Quaternion(0, 0, -1, 0), Quaternion(1, 1, 1e-3, 0)};
+    std::vector<Quaternion> result = ensiie::deduplicateRotations(q.data(), q.size(), 0.01);
+    CHECK(result.size() == 2);
+    CHECK_NEAR(result[0].getT(), std::sqrt(0.5), 1e-15);
+    CHECK_NEAR(result[0].getU(), std::sqrt(0.5), 1e-15);
+    CHECK(result[1] == Quaternion(0, 0, 1, 0));
+}
+
+TEST(hash_rotation_hash)
+{
+    ensiie::RotationHash hash(0.01);
+    ensiie::RotationEqual equal(0.01);
+    Quaternion q(0.3, -0.1, 0.8, 0.2);
+    CHECK(hash(q) == hash(-q * 3));
+    CHECK(equal(q, -q * 3));
+    CHECK(!equal(q, Quaternion(0.3, 0.1, 0.8, 0.2)));
+    CHECK(ensiie::canonical(Quaternion(-0.0, -1, 2, 0)) == Quaternion(0, 1, -2, 0));
+}
+
+TEST(hash_arguments)
+{
+    const double inf = std::numeric_limits<double>::infinity(), nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<Quaternion> q = {Quaternion(1, 0, 0, 0), Quaternion(0, 1, 0, 0)};
+    for (double tolerance : {0.0, -1.0, inf, nan})
+    {
+        CHECK_THROWS(ensiie::clusterRotations(q.data(), q.size(), tolerance), std::invalid_argument);
+        CHECK_THROWS(ensiie::RotationHash{tolerance}, std::invalid_argument);
+    }
+    for (const Quaternion& invalid : {Quaternion(0, 0, 0, 0), Quaternion(nan, 0, 0, 0), Quaternion(1, inf, 0, 0)})
+    {
+        q.push_back(invalid);
+        CHECK_THROWS(ensiie::clusterRotations(q.data(), q.size(), 0.1), std::invalid_argument);
+        q.pop_back();
+    }
+    CHECK_THROWS(ensiie::RotationHash(0.1)(Quaternion(nan, 0, 0, 0)), std::invalid_argument);
+    CHECK_THROWS(ensiie::RotationEqual(0.1)(Quaternion(1, 0, 0, 0), Quaternion(inf, 0, 0, 0)), std::invalid_argument);
+
+    // Tolerances under the resolution of the doubles only merge equal rotations.
+    q = {Quaternion(1, 2, 3, 4), Quaternion(2, 4, 6, 8), Quaternion(1, 2, 3, 4 + 1e-12),
+         Quaternion(-1, -2, -3, -4)};
+    for (double tolerance : {1e-18, 1e-300, std::numeric_limits<double>::denorm_min()})
+    {
+        RotationClusters clusters = ensiie::clusterRotations(q.data(), q.size(), tolerance);
+        CHECK(clusters.representatives == std::vector<std::size_t>({0, 2}));
+        CHECK(clusters.labels == std::vector<std::size_t>({0, 0, 1, 0}));
+        ensiie::RotationHash hash(tolerance);
+        ensiie::RotationEqual equal(tolerance);
+        CHECK(hash(q[0]) == hash(q[3]));
+        CHECK(equal(q[0], q[1]));
+    }
+}
@@ -0,0 +1,195 @@
+/**
+ * @file test_math.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Tests the error bounds of quaternion_math.h against long double, and the fallbacks outside the domains.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "quaternion.h"
+#include "quaternion_c.h"
+#include "quaternion_math.h"
+#include "test.h"
+#include <algorithm>
+#include <limits>
+#include <random>
+
+using ensiie::Accuracy;
+
+namespace
+{
+    constexpr double INF = std::numeric_limits<double>::infinity();
+
+    /**
+     * @brief Error of r in units in the last place of the double nearest to the reference.
+     *
+     */
+    double ulps(double r, long double reference)
+    {
+        double nearest = static_cast<double>(reference);
+        double ulp = std::nextafter(std::abs(nearest), INF) - std::abs(nearest);
+        return static_cast<double>(std::abs(r - reference) / ulp);
+    }
+
+    /**
+     * @brief Largest errors of sincos over random angles in [-range, range], in ULP and absolute.
+     *
+     */
+    template <Accuracy A>
+    void sincosErrors(double range, double& maxUlp, double& maxAbsolute)
+    {
+        std::mt19937_64 random(1);
+        std::uniform_real_distribution<double> angle(-range, range);
+        maxUlp = maxAbsolute = 0;
+        for (int i = 0; i < 200000; i++)
+        {
+            double x = angle(random);
+            double s, c;
+            ensiie::math::sincos<A>(x, s, c);
+            long double rs = sinl(x), rc = cosl(x);
+            maxUlp = std::max(maxUlp, std::max(ulps(s, rs), ulps(c, rc)));
+            maxAbsolute = std::max(maxAbsolute, static_cast<double>(std::max(std::abs(s - rs), std::abs(c - rc))));
+        }
+    }
+}
+
+TEST(math_sincos_bounds)
+{
+    double maxUlp, maxAbsolute;
+    for (double range : {1.0, 100.0, ensiie::math::SINCOS_DOMAIN})
+    {
+        sincosErrors<Accuracy::Ulp>(range, maxUlp, maxAbsolute);
+        CHECK(maxUlp <= 3);
+        sincosErrors<Accuracy::Fast>(range, maxUlp, maxAbsolute);
+        CHECK(maxAbsolute <= 2e-9);
+    }
+}
+
+TEST(math_sincos_quadrants)
+{
+    // Every quadrant, both signs, and the ties of the rounding of k / 4.
+    for (int k = -12; k <= 12; k++)
+    {
+        for (double offset : {-0.7, -0.1, 0.0, 0.1, 0.7})
+        {
+            double x = k * ensiie::math::PIO2 + offset;
+            double s, c;
+            ensiie::math::sincosUnchecked<Accuracy::Ulp>(x, s, c);
+            CHECK_NEAR(s, std::sin(x), 1e-15);
+            CHECK_NEAR(c, std::cos(x), 1e-15);
+            ensiie::math::sincosUnchecked<Accuracy::Fast>(x, s, c);
+            CHECK_NEAR(s, std::sin(x), 2e-9);
+            CHECK_NEAR(c, std::cos(x), 2e-9);
+        }
+    }
+}
+
+TEST(math_sincos_outside_domain)
+{
+    // Beyond the domain, <cmath> gives the exact results, instead of the wrong quadrant of an overflowed conversion.
+    for (double x : {1e10, -1e10, 3.5e9, 1e300, -ensiie::math::SINCOS_DOMAIN})
+    {
+        double s, c;
+        ensiie::math::sincos<Accuracy::Fast>(x, s, c);
+        CHECK(s == std::sin(x) && c == std::cos(x));
+        ensiie::math::sincos<Accuracy::Ulp>(x, s, c);
+        CHECK(s == std::sin(x) && c == std::cos(x));
+    }
+    double s, c;
+    ensiie::math::sincos<Accuracy::Ulp>(INF, s, c);
+    CHECK(std::isnan(s) && std::isnan(c));
+    ensiie::math::sincos<Accuracy::Fast>(std::numeric_limits<double>::quiet_NaN(), s, c);
+    CHECK(std::isnan(s) && std::isnan(c));
+}
+
+TEST(math_acos_bounds)
+{
+    double maxUlp = 0, maxAbsolute = 0;
+    for (int i = -200000; i <= 200000; i++)
+    {
+        double x = i / 200000.0;
+        long double reference = acosl(x);
+        maxUlp = std::max(maxUlp, ulps(ensiie::math::acos<Accuracy::Ulp>(x), reference));
+        maxAbsolute = std::max(maxAbsolute, static_cast<double>(std::abs(ensiie::math::acos<Accuracy::Fast>(x) - reference)));
+    }
+    CHECK(maxUlp <= 2);
+    CHECK(maxAbsolute <= 3e-8);
+    CHECK(std::isnan(ensiie::math::acos<Accuracy::Ulp>(1.5)));
+}
+
+TEST(math_atan2_bounds)
+{
+    std::mt19937_64 random(2);
+    std::uniform_real_distribution<double> coordinate(-10, 10);
+    double maxUlp = 0, maxAbsolute = 0;
+    for (int i = 0; i < 400000; i++)
+    {
+        double y = coordinate(random), x = coordinate(random);
+        long double reference = atan2l(y, x);
+        maxUlp = std::max(maxUlp, ulps(ensiie::math::atan2<Accuracy::Ulp>(y, x), reference));
+        maxAbsolute = std::max(maxAbsolute, static_cast<double>(std::abs(ensiie::math::atan2<Accuracy::Fast>(y, x) - reference)));
+    }
+    CHECK(maxUlp <= 3);
+    CHECK(maxAbsolute <= 2e-8);
+    for (double y : {INF, -INF, 1.0, 0.0})
+    {
+        for (double x : {INF, -INF, 1.0, -1.0})
+        {
+            if (std::isinf(x) || std::isinf(y))
+            {
+                CHECK(ensiie::math::atan2<Accuracy::Ulp>(y, x) == std::atan2(y, x));
+                CHECK(ensiie::math::atan2<Accuracy::Fast>(y, x) == std::atan2(y, x));
+            }
+        }
+    }
+}
+
+TEST(math_exp_huge)
+{
+    // The vector part is an angle far outside the domain of the approximations.
+    for (double u : {1e6, 3.5e9, 1e10, 1e150})
+    {
+        ensiie::Quaternion q(0.5, u, -u, u);
+        ensiie::Quaternion exact = q.exp();
+        for (Accuracy accuracy : {Accuracy::Ulp, Accuracy::Fast})
+        {
+            ensiie::Quaternion r = q.exp(accuracy);
+            CHECK(std::isfinite(r.getT()) && std::isfinite(r.getU()));
+            CHECK((r - exact).norm() <= 1e-15 * exact.norm());
+        }
+    }
+}
+
+TEST(math_slerp_close)
+{
+    // Nearly identical unit quaternions, where acos(dot) loses half the digits.
+    ensiie::Quaternion a = ensiie::Quaternion(0.3, -0.5, 0.7, 0.4).normalize();
+    for (double angle : {1e-3, 1e-6, 1e-9})
+    {
+        ensiie::Quaternion b = a * ensiie::Quaternion::fromAxisAngle(1, 2, 3, angle);
+        double s = 0.3;
+        long double c = cosl(0.5L * s * angle), sn = sinl(0.5L * s * angle) / sqrtl(14);
+        // Expected a * (c, sn * (1, 2, 3)), computed in long double.
+        long double r[4] = {a.getT() * c - sn * (a.getU() + 2 * a.getV() + 3 * a.getW()),
+                            a.getU() * c + sn * (a.getT() + 3 * a.getV() - 2 * a.getW()),
+                            a.getV() * c + sn * (2 * a.getT() - 3 * a.getU() + a.getW()),
+                            a.getW() * c + sn * (3 * a.getT() + 2 * a.getU() - a.getV())};
+        for (int accuracy : {QUAT_ACCURACY_EXACT, QUAT_ACCURACY_ULP})
+        {
+            double qa[4] = {a.getT(), a.getU(), a.getV(), a.getW()};
+            double qb[4] = {b.getT(), b.getU(), b.getV(), b.getW()};
+            double out[4];
+            CHECK(quat_slerp_ex(1, qa, 4, qb, 4, &s, 0, out, 4, QUAT_LAYOUT_WXYZ, accuracy) == QUAT_OK);
+            ensiie::Quaternion scalar = ensiie::Quaternion::slerp(a, b, s, static_cast<Accuracy>(accuracy));
+            double scalarOut[4] = {scalar.getT(), scalar.getU(), scalar.getV(), scalar.getW()};
+            for (int k = 0; k < 4; k++)
+            {
+                CHECK_NEAR(out[k], r[k], 1e-15);
+                CHECK_NEAR(scalarOut[k], r[k], 1e-15);
+            }
+        }
+    }
+}
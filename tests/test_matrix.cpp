@@ -0,0 +1,93 @@
+/**
+ * @file test_matrix.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Tests the matrix product against the naive product, across tiles, register blocks and threads.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "quaternion_matrix.h"
+#include "test.h"
+#include <stdexcept>
+
+using ensiie::Quaternion;
+using ensiie::QuaternionMatrix;
+
+namespace
+{
+    /**
+     * @brief A matrix of small integers, whose products are summed exactly in any order.
+     *
+     */
+    QuaternionMatrix matrix(std::size_t rows, std::size_t cols, int seed)
+    {
+        QuaternionMatrix m(rows, cols);
+        for (int p = 0; p < 4; p++)
+        {
+            for (std::size_t k = 0; k < rows * cols; k++)
+            {
+                m.plane(p)[k] = static_cast<double>((k * 7 + static_cast<std::size_t>(p * 5 + seed) * 11) % 9) - 4;
+            }
+        }
+        return m;
+    }
+
+    QuaternionMatrix naive(const QuaternionMatrix& a, const QuaternionMatrix& b, const QuaternionMatrix& c)
+    {
+        QuaternionMatrix result = c;
+        for (std::size_t i = 0; i < a.getRows(); i++)
+        {
+            for (std::size_t j = 0; j < b.getCols(); j++)
+            {
+                Quaternion sum = result.get(i, j);
+                for (std::size_t k = 0; k < a.getCols(); k++)
+                {
+                    sum = sum + a.get(i, k) * b.get(k, j);
+                }
+                result.set(i, j, sum);
+            }
+        }
+        return result;
+    }
+}
+
+TEST(matrix_gemm_matches_naive)
+{
+    // Sizes below and across the register blocks, the tiles and the tasks, with odd remainders.
+    const std::size_t sizes[][3] = {{1, 1, 1}, {1, 5, 3}, {3, 7, 1}, {5, 3, 9}, {37, 53, 71}, {130, 300, 270}, {2, 129, 515}};
+    for (const auto& size : sizes)
+    {
+        QuaternionMatrix a = matrix(size[0], size[1], 1), b = matrix(size[1], size[2], 2), c0 = matrix(size[0], size[2], 3);
+        QuaternionMatrix expected = naive(a, b, c0);
+        for (unsigned threads : {1u, 3u, 0u})
+        {
+            QuaternionMatrix c = c0;
+            ensiie::gemm(a, b, c, threads);
+            CHECK(c == expected);
+        }
+    }
+}
+
+TEST(matrix_order_of_factors)
+{
+    QuaternionMatrix a(1, 1), b(1, 1);
+    a.set(0, 0, Quaternion(0, 1, 0, 0));
+    b.set(0, 0, Quaternion(0, 0, 1, 0));
+    CHECK((a * b).get(0, 0) == Quaternion(0, 0, 0, 1));
+    CHECK((b * a).get(0, 0) == Quaternion(0, 0, 0, -1));
+}
+
+TEST(matrix_gemm_arguments)
+{
+    QuaternionMatrix a = matrix(3, 4, 1), b = matrix(4, 5, 2), c(3, 5), d(3, 4);
+    CHECK_THROWS(ensiie::gemm(a, a, c), std::invalid_argument);
+    CHECK_THROWS(ensiie::gemm(a, b, d), std::invalid_argument);
+    QuaternionMatrix square = matrix(4, 4, 1);
+    CHECK_THROWS(ensiie::gemm(square, square, square), std::invalid_argument);
+    QuaternionMatrix empty(3, 0), wide(0, 5), zero(3, 5);
+    ensiie::gemm(empty, wide, zero);
+    CHECK(zero == QuaternionMatrix(3, 5));
+}
@@ -0,0 +1,152 @@
+/**
+ * @file test_mekf.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Tests the bank of attitude filters: integration of the rates, convergence of the updates and skipped sensors.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "batch_mekf.h"
+#include "test.h"
+#include <stdexcept>
+#include <vector>
+
+using ensiie::Accuracy;
+using ensiie::BatchMekf;
+using ensiie::Quaternion;
+
+namespace
+{
+    /**
+     * @brief Angle of the rotation between two unit quaternions.
+     *
+     */
+    double angle(const Quaternion& a, const Quaternion& b)
+    {
+        Quaternion c = Quaternion::dot(a, b) < 0 ? -b : b;
+        return 4 * std::atan2((a - c).norm(), (a + c).norm());
+    }
+
+    /**
+     * @brief Direction of the world measured in the body frame of an orientation q.
+     *
+     */
+    void measure(const Quaternion& q, const double reference[3], double* m)
+    {
+        double x = reference[0], y = reference[1], z = reference[2];
+        q.conjugate().rotate(x, y, z);
+        m[0] = x;
+        m[1] = y;
+        m[2] = z;
+    }
+}
+
+TEST(mekf_arguments)
+{
+    CHECK_THROWS(BatchMekf(4, 0), std::invalid_argument);
+    BatchMekf bank(2);
+    double gyro[6] = {};
+    CHECK_THROWS(bank.predict(gyro, -1, 0), std::invalid_argument);
+    CHECK_THROWS(bank.predict(gyro, 1, -1), std::invalid_argument);
+    double reference[3] = {0, 0, 0};
+    CHECK_THROWS(bank.update(gyro, reference, 1), std::invalid_argument);
+}
+
+TEST(mekf_predict_integrates_rates)
+{
+    // Constant rates about fixed axes, for each accuracy.
+    const double rates[3][3] = {{0, 0, 0.5}, {1, -2, 0.3}, {0, 0, 0}};
+    for (Accuracy accuracy : {Accuracy::Exact, Accuracy::Ulp, Accuracy::Fast})
+    {
+        BatchMekf bank(3);
+        std::vector<double> gyro(&rates[0][0], &rates[0][0] + 9);
+        for (int step = 0; step < 100; step++)
+        {
+            bank.predict(gyro.data(), 0.01, 1e-4, accuracy);
+        }
+        for (int i = 0; i < 3; i++)
+        {
+            double norm = std::sqrt(rates[i][0] * rates[i][0] + rates[i][1] * rates[i][1] + rates[i][2] * rates[i][2]);
+            Quaternion expected = norm == 0 ? Quaternion::identity()
+                                            : Quaternion::fromAxisAngle(rates[i][0], rates[i][1], rates[i][2], norm);
+            CHECK(angle(bank.getAttitude(i), expected) < 1e-7);
+            double p[3][3];
+            bank.getCovariance(i, p);
+            // The noise adds to the variances, the rotation keeping the trace.
+            CHECK_NEAR(p[0][0] + p[1][1] + p[2][2], 3 + 3 * 1e-4, 1e-12);
+            CHECK(p[0][1] == p[1][0] && p[0][2] == p[2][0] && p[1][2] == p[2][1]);
+        }
+    }
+}
+
+TEST(mekf_predict_outside_domain)
+{
+    // A half angle beyond the domain of the approximations falls back to the exact functions.
+    double gyro[3] = {3e5, 0, 0};
+    BatchMekf exact(1), ulp(1);
+    exact.predict(gyro, 1, 0);
+    ulp.predict(gyro, 1, 0, Accuracy::Ulp);
+    CHECK(angle(exact.getAttitude(0), ulp.getAttitude(0)) < 1e-12);
+    CHECK(std::isfinite(ulp.getAttitude(0).getT()));
+}
+
+TEST(mekf_update_converges)
+{
+    const int n = 64;
+    BatchMekf bank(n);
+    std::vector<Quaternion> truth;
+    for (int i = 0; i < n; i++)
+    {
+        truth.push_back(Quaternion::fromAxisAngle(std::cos(i), std::sin(3 * i), 0.5, 0.05 * i));
+    }
+    // Two directions, such as gravity and the magnetic field, make the attitude observable.
+    const double gravity[3] = {0, 0, 1};
+    const double north[3] = {0.6, 0, 0.8};
+    std::vector<double> measurements(3 * n), gyro(3 * n, 0);
+    for (int step = 0; step < 100; step++)
+    {
+        // The process noise keeps the gain up while the linearization error of the first updates is corrected.
+        bank.predict(gyro.data(), 0.01, 1e-2);
+        const double* reference = step % 2 == 0 ? gravity : north;
+        for (int i = 0; i < n; i++)
+        {
+            measure(truth[i], reference, &measurements[3 * i]);
+        }
+        bank.update(measurements.data(), reference, 1e-4);
+    }
+    for (int i = 0; i < n; i++)
+    {
+        CHECK(angle(bank.getAttitude(i), truth[i]) < 1e-6);
+        double p[3][3];
+        bank.getCovariance(i, p);
+        CHECK(p[0][0] > 0 && p[1][1] > 0 && p[2][2] > 0);
+        CHECK(p[0][0] + p[1][1] + p[2][2] < 1e-3);
+    }
+}
+
+TEST(mekf_null_measurement_skips)
+{
+    BatchMekf bank(2);
+    Quaternion q = Quaternion(0.9, 0.1, -0.3, 0.2).normalize();
+    bank.reset(0, q, 0.5);
+    bank.reset(1, q, 0.5);
+    const double gravity[3] = {0, 0, 9.81};
+    double measurements[6] = {0, 0, 0, 1, 0, 0};
+    bank.update(measurements, gravity, 0.01);
+
+    // The first filter, without a sample, is unchanged; the second one moved.
+    Quaternion first = bank.getAttitude(0);
+    CHECK_NEAR(first.getT(), q.getT(), 1e-15);
+    CHECK_NEAR(first.getU(), q.getU(), 1e-15);
+    CHECK_NEAR(first.getV(), q.getV(), 1e-15);
+    CHECK_NEAR(first.getW(), q.getW(), 1e-15);
+    double p[3][3];
+    bank.getCovariance(0, p);
+    CHECK(p[0][0] == 0.5 && p[1][1] == 0.5 && p[2][2] == 0.5 && p[0][1] == 0 && p[0][2] == 0 && p[1][2] == 0);
+    CHECK(angle(bank.getAttitude(1), q) > 1e-3);
+    bank.getCovariance(1, p);
+    CHECK(p[0][0] + p[1][1] < 1);
+}
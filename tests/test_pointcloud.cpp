@@ -0,0 +1,153 @@
+/**
+ * @file test_pointcloud.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Tests the rotation of point cloud files: tiles and groups, in place through another path, and the
+ * files left untouched by invalid arguments.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "pointcloud.h"
+#include "test.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using ensiie::PointCloudOptions;
+using ensiie::PointFormat;
+using ensiie::Quaternion;
+using test::TemporaryDirectory;
+
+namespace
+{
+    template <typename T>
+    void write(const std::string& path, const std::vector<T>& values)
+    {
+        std::ofstream f(path, std::ios::binary);
+        f.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    template <typename T>
+    std::vector<T> read(const std::string& path)
+    {
+        std::ifstream f(path, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        std::vector<T> values(bytes.size() / sizeof(T));
+        std::copy(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(values.size() * sizeof(T)),
+                  reinterpret_cast<char*>(values.data()));
+        return values;
+    }
+
+    template <typename T>
+    std::vector<T> cloud(std::size_t points)
+    {
+        std::vector<T> values(3 * points);
+        for (std::size_t i = 0; i < values.size(); i++)
+        {
+            values[i] = static_cast<T>(std::sin(0.37 * static_cast<double>(i)) * 10);
+        }
+        return values;
+    }
+
+    /**
+     * @brief Largest difference between the points rotated by the files and by Quaternion::rotate().
+     *
+     */
+    template <typename T>
+    double error(const std::vector<T>& in, const std::vector<T>& out, const Quaternion* rotations, std::size_t groupSize)
+    {
+        double largest = in.size() == out.size() ? 0 : std::numeric_limits<double>::infinity();
+        for (std::size_t p = 0; 3 * p < in.size() && in.size() == out.size(); p++)
+        {
+            double x = in[3 * p], y = in[3 * p + 1], z = in[3 * p + 2];
+            rotations[p / groupSize].normalize().rotate(x, y, z);
+            largest = std::max({largest, std::abs(x - out[3 * p]), std::abs(y - out[3 * p + 1]), std::abs(z - out[3 * p + 2])});
+        }
+        return largest;
+    }
+}
+
+TEST(pointcloud_tiles)
+{
+    TemporaryDirectory dir("tiles");
+    // 5000 points of 12 bytes span several tiles of one page, the last one partial.
+    std::vector<float> in = cloud<float>(5000);
+    write(dir.file("in"), in);
+    PointCloudOptions options;
+    options.threads = 3;
+    options.tileBytes = 1;
+    Quaternion q(1, 2, -3, 0.5);
+    CHECK(ensiie::rotatePointCloud(dir.file("in"), dir.file("out"), q, options) == 5000);
+    CHECK(read<float>(dir.file("in")) == in);
+    CHECK(error(in, read<float>(dir.file("out")), &q, 5000) < 1e-5);
+}
+
+TEST(pointcloud_groups)
+{
+    TemporaryDirectory dir("groups");
+    std::vector<double> in = cloud<double>(4 * 1000);
+    write(dir.file("in"), in);
+    PointCloudOptions options;
+    options.format = PointFormat::Float64;
+    options.threads = 4;
+    options.tileBytes = 4096;
+    Quaternion rotations[4] = {Quaternion(1, 0, 0, 0), Quaternion(0, 1, 0, 0), Quaternion(1, 1, 1, 1), Quaternion(-2, 0, 3, 1)};
+    CHECK(ensiie::rotatePointGroups(dir.file("in"), dir.file("out"), rotations, 4, 1000, options) == 4000);
+    CHECK(error(in, read<double>(dir.file("out")), rotations, 1000) < 1e-13);
+    CHECK_THROWS(ensiie::rotatePointGroups(dir.file("in"), dir.file("out"), rotations, 3, 1000, options), std::invalid_argument);
+}
+
+TEST(pointcloud_in_place)
+{
+    TemporaryDirectory dir("in_place");
+    std::vector<float> in = cloud<float>(3000);
+    Quaternion q(0, 0, 0, 1);
+    for (const std::string& output : {std::string(), dir.file("in"), dir.file("./in"), dir.file("link")})
+    {
+        write(dir.file("in"), in);
+        std::filesystem::remove(dir.file("link"));
+        std::filesystem::create_hard_link(dir.file("in"), dir.file("link"));
+        PointCloudOptions options;
+        options.tileBytes = 1;
+        CHECK(ensiie::rotatePointCloud(dir.file("in"), output, q, options) == 3000);
+        // The output is not truncated before the input is read, whatever its path.
+        CHECK(error(in, read<float>(dir.file("in")), &q, 3000) < 1e-5);
+    }
+}
+
+TEST(pointcloud_invalid_rotations)
+{
+    TemporaryDirectory dir("invalid");
+    std::vector<float> in = cloud<float>(200);
+    std::vector<float> previous = cloud<float>(10);
+    write(dir.file("in"), in);
+    write(dir.file("out"), previous);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    Quaternion rotations[4] = {Quaternion(1, 0, 0, 0), Quaternion(1, 2, 3, 4), Quaternion(1, 0, 0, 0), Quaternion(0, 0, 0, 0)};
+    // The last rotation is null: nothing is written, in place or not.
+    CHECK_THROWS(ensiie::rotatePointGroups(dir.file("in"), dir.file("out"), rotations, 4, 50), std::invalid_argument);
+    CHECK_THROWS(ensiie::rotatePointGroups(dir.file("in"), "", rotations, 4, 50), std::invalid_argument);
+    CHECK_THROWS(ensiie::rotatePointCloud(dir.file("in"), dir.file("out"), Quaternion(nan, 0, 0, 1)), std::invalid_argument);
+    // Near-null rotations are reported with their index, not as a division by zero.
+    rotations[3] = Quaternion(1e-16, 0, 0, 0);
+    std::string message;
+    try
+    {
+        ensiie::rotatePointGroups(dir.file("in"), dir.file("out"), rotations, 4, 50);
+    }
+    catch (const std::invalid_argument& e)
+    {
+        message = e.what();
+    }
+    CHECK(message == "Rotation 3 is null or not finite");
+    CHECK(read<float>(dir.file("in")) == in);
+    CHECK(read<float>(dir.file("out")) == previous);
+}
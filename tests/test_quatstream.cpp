@@ -0,0 +1,158 @@
+/**
+ * @file test_quatstream.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Tests the quatstream tool on small files: formats, layouts and operations, and each rejected input.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * make test builds bin/quatstream and runs the cases from the root of the repository.
+ *
+ */
+
+#include "test.h"
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+
+using test::TemporaryDirectory;
+
+namespace
+{
+    const char* const QUATSTREAM = "bin/quatstream";
+
+    /**
+     * @brief Output, errors and exit status of a run of quatstream.
+     *
+     */
+    struct Run
+    {
+        std::string out, err;
+        int status;
+    };
+
+    void write(const std::string& path, const std::string& bytes)
+    {
+        std::ofstream f(path, std::ios::binary);
+        f << bytes;
+    }
+
+    std::string read(const std::string& path)
+    {
+        std::ifstream f(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    }
+
+    /**
+     * @brief Runs quatstream with the arguments on an input.
+     *
+     */
+    Run run(const TemporaryDirectory& dir, const std::string& input, const std::string& arguments)
+    {
+        write(dir.file("in"), input);
+        std::string command = std::string(QUATSTREAM) + " " + arguments + " < " + dir.file("in") + " > " +
+                              dir.file("out") + " 2> " + dir.file("err");
+        int status = std::system(command.c_str());
+        return {read(dir.file("out")), read(dir.file("err")), WIFEXITED(status) ? WEXITSTATUS(status) : -1};
+    }
+
+    /**
+     * @brief Whether a run failed with a message.
+     *
+     */
+    bool rejects(const TemporaryDirectory& dir, const std::string& input, const std::string& arguments,
+                 const std::string& message)
+    {
+        Run r = run(dir, input, arguments);
+        if (r.status != 1 || r.err != "quatstream: " + message + "\n")
+        {
+            std::string err = r.err.substr(0, r.err.find('\n'));
+            std::fprintf(stderr, "  quatstream %s: status %d, \"%s\"\n", arguments.c_str(), r.status, err.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    std::vector<double> numbers(const std::string& text)
+    {
+        std::istringstream s(text);
+        std::vector<double> values;
+        for (double x; s >> x;)
+        {
+            values.push_back(x);
+        }
+        return values;
+    }
+
+    std::string binary(const std::vector<double>& values)
+    {
+        return std::string(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+    }
+}
+
+TEST(quatstream_formats)
+{
+    TemporaryDirectory dir("quatstream_formats");
+    // Comments, blank lines, commas and CR LF ends of lines.
+    const std::string text = "1 2 3 4\n# comment\n\n  0.5,0,0,1\r\n";
+    Run r = run(dir, text, "conjugate");
+    CHECK(r.status == 0);
+    CHECK(numbers(r.out) == std::vector<double>({1, -2, -3, -4, 0.5, 0, 0, -1}));
+
+    r = run(dir, text, "--out binary");
+    CHECK(r.status == 0 && r.out == binary({1, 2, 3, 4, 0.5, 0, 0, 1}));
+    r = run(dir, binary({1, 2, 3, 4}), "--in binary right:0,1,0,0");
+    CHECK(r.status == 0 && numbers(r.out) == std::vector<double>({-2, 1, 4, -3}));
+
+    // The operations apply to t, u, v, w whatever the layouts.
+    r = run(dir, "2 3 4 1\n", "--in-layout xyzw left:0,1,0,0");
+    CHECK(r.status == 0 && numbers(r.out) == std::vector<double>({-2, 1, -4, 3}));
+    r = run(dir, "1 2 3 4\n", "--out-layout xyzw");
+    CHECK(r.status == 0 && numbers(r.out) == std::vector<double>({2, 3, 4, 1}));
+
+    // Many chunks, in order.
+    std::string many;
+    for (int i = 0; i < 1000; i++)
+    {
+        many += std::to_string(i) + " 0 0 0\n";
+    }
+    r = run(dir, many, "--chunk 7 --buffers 3");
+    CHECK(r.status == 0 && numbers(r.out) == numbers(many));
+}
+
+TEST(quatstream_line_length)
+{
+    TemporaryDirectory dir("quatstream_lines");
+    const std::string numbers = "1 2 3 4";
+    const std::string longest = numbers + std::string(1023 - numbers.size(), ' ');
+    CHECK(run(dir, longest + "\n", "").status == 0);
+    CHECK(run(dir, longest + "\r\n", "").status == 0);
+    CHECK(run(dir, longest, "").status == 0);
+    for (const char* end : {"\n", "\r\n", ""})
+    {
+        CHECK(rejects(dir, "1 0 0 0\n" + longest + " " + end, "", "Line 2: longer than 1023 characters"));
+    }
+    CHECK(rejects(dir, longest + std::string(5000, ' ') + "\n", "", "Line 1: longer than 1023 characters"));
+}
+
+TEST(quatstream_rejections)
+{
+    TemporaryDirectory dir("quatstream_rejections");
+    CHECK(rejects(dir, "1 2 3 4\n1 2 3\n", "", "Line 2: expected 4 numbers"));
+    CHECK(rejects(dir, "1 2 x 4\n", "", "Line 1: expected 4 numbers"));
+    CHECK(rejects(dir, "1 2 3 4 5\n", "", "Line 1: expected 4 numbers, got more"));
+    CHECK(rejects(dir, binary({1, 2, 3, 4, 5}), "--in binary", "Truncated binary input: 8 trailing bytes after the last quaternion"));
+    CHECK(rejects(dir, binary({1, 2, 3, 4}) + "x", "--in binary", "Truncated binary input: 1 trailing bytes after the last quaternion"));
+    CHECK(rejects(dir, "", "--in xml", "Unknown format: xml"));
+    CHECK(rejects(dir, "", "--out-layout zyx", "Unknown layout: zyx"));
+    CHECK(rejects(dir, "", "bogus", "Unknown operation: bogus"));
+    CHECK(rejects(dir, "", "left:1,2", "Expected 4 comma-separated numbers: left:1,2"));
+    CHECK(rejects(dir, "", "--chunk 0", "The chunk size must be positive and there must be at least 3 buffers"));
+    CHECK(rejects(dir, "", "--buffers 2", "The chunk size must be positive and there must be at least 3 buffers"));
+    CHECK(rejects(dir, "", "-i " + dir.file("missing"), "Cannot open " + dir.file("missing")));
+}
@@ -0,0 +1,121 @@
+/**
+ * @file test_random.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Tests the random rotations: known answers of Philox, sequences independent of their partition, and moments.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "quaternion_random.h"
+#include "test.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using ensiie::Accuracy;
+using ensiie::Quaternion;
+
+namespace
+{
+    constexpr Accuracy ACCURACIES[] = {Accuracy::Exact, Accuracy::Ulp, Accuracy::Fast};
+
+    /**
+     * @brief Draws first .. first + n - 1 of a sequence in pieces of the given sizes, repeated until n.
+     *
+     */
+    template <typename Draw>
+    std::vector<Quaternion> pieces(std::uint64_t first, std::size_t n, const std::vector<std::size_t>& sizes, const Draw& draw)
+    {
+        std::vector<Quaternion> q(n);
+        for (std::size_t i = 0, k = 0; i < n; k++)
+        {
+            std::size_t size = std::min(n - i, sizes[k % sizes.size()]);
+            draw(first + i, q.data() + i, size);
+            i += size;
+        }
+        return q;
+    }
+}
+
+TEST(random_philox_known_answer)
+{
+    // Philox4x32-10 of the counter 0 and the key 0 (Salmon et al., 2011): 6627e8d5 e169c58d bc57ac4c 9b00dbd8.
+    // The first two words give the 53 bits of u0, and the last two the 32 bits of u1 and u2.
+    double u0 = static_cast<double>(0xe169c58d6627e8d5 >> 11) * 0x1p-53;
+    double u1 = static_cast<double>(0xbc57ac4c) * 0x1p-32;
+    double u2 = static_cast<double>(0x9b00dbd8) * 0x1p-32;
+    for (Accuracy accuracy : ACCURACIES)
+    {
+        Quaternion q;
+        ensiie::uniformRotations(0, 0, &q, 1, accuracy);
+        // Shoemake: (sqrt(u0) cos(2 pi u2), sqrt(1 - u0) sin(2 pi u1), sqrt(1 - u0) cos(2 pi u1), sqrt(u0) sin(2 pi u2)).
+        double tolerance = accuracy == Accuracy::Fast ? 1e-7 : 1e-12;
+        CHECK_NEAR(q.getT() * q.getT() + q.getW() * q.getW(), u0, tolerance);
+        double angle = std::atan2(q.getU(), q.getV());
+        CHECK_NEAR(angle < 0 ? angle + 2 * ensiie::math::PI : angle, 2 * ensiie::math::PI * u1, tolerance);
+        angle = std::atan2(q.getW(), q.getT());
+        CHECK_NEAR(angle < 0 ? angle + 2 * ensiie::math::PI : angle, 2 * ensiie::math::PI * u2, tolerance);
+    }
+}
+
+TEST(random_partitions)
+{
+    // Any partition of a sequence between calls, or threads, draws the same rotations.
+    const std::uint64_t first = (std::uint64_t(1) << 32) - 300;
+    for (Accuracy accuracy : ACCURACIES)
+    {
+        auto uniform = [&](std::uint64_t i, Quaternion* out, std::size_t n) {
+            ensiie::uniformRotations(42, i, out, n, accuracy);
+        };
+        auto perturbed = [&](std::uint64_t i, Quaternion* out, std::size_t n) {
+            ensiie::perturbedRotations(Quaternion(1, 2, 3, 4).normalize(), 0.3, 42, i, out, n, accuracy);
+        };
+        std::vector<Quaternion> u = pieces(first, 1000, {1000}, uniform), p = pieces(first, 1000, {1000}, perturbed);
+        for (const std::vector<std::size_t>& sizes : std::vector<std::vector<std::size_t>>{{1}, {7, 1, 64}, {299, 2}, {333}})
+        {
+            CHECK(pieces(first, 1000, sizes, uniform) == u);
+            CHECK(pieces(first, 1000, sizes, perturbed) == p);
+        }
+        std::vector<Quaternion> other(1000);
+        ensiie::uniformRotations(43, first, other.data(), other.size(), accuracy);
+        CHECK(other != u);
+    }
+}
+
+TEST(random_moments)
+{
+    const std::size_t n = 20000;
+    std::vector<Quaternion> q(n);
+    for (Accuracy accuracy : ACCURACIES)
+    {
+        ensiie::uniformRotations(7, 0, q.data(), n, accuracy);
+        double largest = 0, squares[4] = {0, 0, 0, 0};
+        for (const Quaternion& r : q)
+        {
+            largest = std::max(largest, std::abs(r.norm() - 1));
+            const double c[4] = {r.getT(), r.getU(), r.getV(), r.getW()};
+            for (int k = 0; k < 4; k++)
+            {
+                squares[k] += c[k] * c[k] / n;
+            }
+        }
+        CHECK(largest < (accuracy == Accuracy::Fast ? 1e-8 : 1e-15));
+        // Uniform rotations are uniform on the sphere of the quaternions: each component squared averages 1/4.
+        for (double s : squares)
+        {
+            CHECK_NEAR(s, 0.25, 0.01);
+        }
+    }
+
+    // Perturbations of sigma 0 are the mean.
+    Quaternion mean = Quaternion(1, -2, 0.5, 3).normalize();
+    ensiie::perturbedRotations(mean, 0, 3, 0, q.data(), 10);
+    for (std::size_t i = 0; i < 10; i++)
+    {
+        CHECK((q[i] - mean).norm() < 1e-15);
+    }
+}
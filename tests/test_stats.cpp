@@ -0,0 +1,295 @@
+/**
+ * @file test_stats.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Tests the instrumentation: exact counts of the operations, faults and kernels, resets, threads which have
+ * exited and sampling. Without QUATERNION_STATS, that it compiles to nothing.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * make test-stats builds bin/tests_stats with QUATERNION_STATS and runs the cases.
+ *
+ */
+
+#include "quaternion.h"
+#include "quaternion_stats.h"
+#include "test.h"
+#include <cstdint>
+#include <stdexcept>
+
+#ifdef QUATERNION_STATS
+#include "batch_mekf.h"
+#include "pointcloud.h"
+#include "quaternion_c.h"
+#include "quaternion_fourier.h"
+#include "quaternion_hash.h"
+#include "quaternion_matrix.h"
+#include "quaternion_random.h"
+#include <cmath>
+#include <fstream>
+#include <thread>
+#include <vector>
+#endif
+
+using ensiie::Quaternion;
+using ensiie::stats::Snapshot;
+
+namespace
+{
+    /**
+     * @brief Number of scalar operations counted in a snapshot.
+     *
+     */
+    std::uint64_t operations(const Snapshot& s)
+    {
+        std::uint64_t n = 0;
+        for (std::uint64_t c : s.operations)
+        {
+            n += c;
+        }
+        return n;
+    }
+
+    /**
+     * @brief Whether nothing at all is counted in a snapshot.
+     *
+     */
+    bool empty(const Snapshot& s)
+    {
+        std::uint64_t n = operations(s);
+        for (std::uint64_t c : s.faults)
+        {
+            n += c;
+        }
+        for (const ensiie::stats::KernelStats& k : s.kernels)
+        {
+            n += k.calls + k.elements + k.sampledCalls + k.sampledElements + k.sampledNanoseconds;
+            for (std::uint64_t b : k.histogram)
+            {
+                n += b;
+            }
+        }
+        return n == 0;
+    }
+}
+
+#ifndef QUATERNION_STATS
+TEST(stats_disabled)
+{
+    CHECK(!ensiie::stats::enabled());
+    CHECK(ensiie::stats::samplingPeriod() == 0);
+    Quaternion q = Quaternion(1, 2, 3, 4) * Quaternion(0, 1, 0, 0);
+    CHECK_THROWS(q / 0.0, std::invalid_argument);
+    ensiie::stats::reset();
+    CHECK(empty(ensiie::stats::snapshot()));
+    CHECK_THROWS(ensiie::stats::setSamplingPeriod(0), std::invalid_argument);
+}
+#else
+using ensiie::stats::Fault;
+using ensiie::stats::Kernel;
+using ensiie::stats::Operation;
+
+namespace
+{
+    const std::uint32_t PERIOD = 64;
+
+    std::uint64_t count(const Snapshot& s, Operation o)
+    {
+        return s.operations[static_cast<int>(o)];
+    }
+
+    std::uint64_t count(const Snapshot& s, Fault f)
+    {
+        return s.faults[static_cast<int>(f)];
+    }
+
+    const ensiie::stats::KernelStats& kernel(const Snapshot& s, Kernel k)
+    {
+        return s.kernels[static_cast<int>(k)];
+    }
+
+    /**
+     * @brief Quaternions of 4 doubles, wxyz.
+     *
+     */
+    std::vector<double> quaternions(std::size_t n)
+    {
+        std::vector<double> q(4 * n);
+        for (std::size_t i = 0; i < q.size(); i++)
+        {
+            q[i] = std::sin(0.7 * static_cast<double>(i)) + 0.1;
+        }
+        return q;
+    }
+}
+
+TEST(stats_snapshot_and_reset)
+{
+    CHECK(ensiie::stats::enabled());
+    ensiie::stats::reset();
+    CHECK(empty(ensiie::stats::snapshot()));
+
+    Quaternion a(1, 2, 3, 4), b(0, 1, 0, 0);
+    Quaternion c = a * b;
+    c = c + a;
+    c *= 2.0;
+    c = c.normalize();
+    c = c.inverse();
+    Snapshot s = ensiie::stats::snapshot();
+    CHECK(count(s, Operation::Multiply) == 1);
+    CHECK(count(s, Operation::Add) == 1);
+    CHECK(count(s, Operation::ScalarMultiply) == 1);
+    // The division by the norm and by its square are internal to normalize() and inverse().
+    CHECK(count(s, Operation::Normalize) == 1);
+    CHECK(count(s, Operation::Inverse) == 1);
+    CHECK(operations(s) == 5);
+    // A snapshot does not reset.
+    CHECK(operations(ensiie::stats::snapshot()) == 5);
+
+    // The counts restart from the baseline of the reset.
+    ensiie::stats::reset();
+    CHECK(empty(ensiie::stats::snapshot()));
+    c = Quaternion::slerp(a.normalize(), b, 0.3);
+    s = ensiie::stats::snapshot();
+    CHECK(count(s, Operation::Slerp) == 1 && count(s, Operation::Normalize) == 1 && operations(s) == 2);
+}
+
+TEST(stats_exited_threads)
+{
+    ensiie::stats::reset();
+    Quaternion a(1, 2, 3, 4), b(0, 1, 0, 0);
+    std::vector<double> q = quaternions(10), out(q.size());
+    std::thread([&] {
+        for (int i = 0; i < 5; i++)
+        {
+            a = a * b;
+        }
+        quat_normalize(10, q.data(), 4, out.data(), 4, QUAT_LAYOUT_WXYZ);
+    }).join();
+    // The counters of the thread were folded when it exited.
+    Snapshot s = ensiie::stats::snapshot();
+    CHECK(count(s, Operation::Multiply) == 5 && operations(s) == 5);
+    CHECK(kernel(s, Kernel::Normalize).calls == 1 && kernel(s, Kernel::Normalize).elements == 10);
+
+    // A reset also restarts the counts of the exited threads.
+    ensiie::stats::reset();
+    CHECK(empty(ensiie::stats::snapshot()));
+    std::thread([&] { a = a - b; }).join();
+    a = a + b;
+    s = ensiie::stats::snapshot();
+    CHECK(count(s, Operation::Subtract) == 1 && count(s, Operation::Add) == 1 && operations(s) == 2);
+}
+
+TEST(stats_sampling)
+{
+    CHECK(ensiie::stats::samplingPeriod() == PERIOD);
+    CHECK_THROWS(ensiie::stats::setSamplingPeriod(0), std::invalid_argument);
+    CHECK(ensiie::stats::samplingPeriod() == PERIOD);
+    ensiie::stats::setSamplingPeriod(4);
+    ensiie::stats::reset();
+    std::vector<double> q = quaternions(7), out(q.size());
+    // A new thread counts its calls from 0: calls 0, 4 and 8 of 10 are timed.
+    std::thread([&] {
+        for (int i = 0; i < 10; i++)
+        {
+            quat_multiply(7, q.data(), 4, q.data(), 4, out.data(), 4, QUAT_LAYOUT_WXYZ);
+        }
+    }).join();
+    ensiie::stats::setSamplingPeriod(PERIOD);
+    Snapshot s = ensiie::stats::snapshot();
+    const ensiie::stats::KernelStats& k = kernel(s, Kernel::Multiply);
+    CHECK(k.calls == 10 && k.elements == 70);
+    CHECK(k.sampledCalls == 3 && k.sampledElements == 21);
+    std::uint64_t histogram = 0;
+    for (std::uint64_t b : k.histogram)
+    {
+        histogram += b;
+    }
+    CHECK(histogram == 3);
+    CHECK(k.sampledNanoseconds > 0 && k.throughput() > 0);
+}
+
+TEST(stats_faults)
+{
+    ensiie::stats::reset();
+    Quaternion a(1, 2, 3, 4);
+    CHECK_THROWS(a / Quaternion(0, 0, 0, 0), std::invalid_argument);
+    CHECK_THROWS(a / 0.0, std::invalid_argument);
+    CHECK_THROWS(Quaternion(0, 0, 0, 0).normalize(), std::invalid_argument);
+    Snapshot s = ensiie::stats::snapshot();
+    CHECK(count(s, Fault::DivisionByZero) == 3);
+    CHECK(count(s, Operation::Divide) == 1 && count(s, Operation::ScalarDivide) == 1 && count(s, Operation::Normalize) == 1);
+    CHECK(operations(s) == 3);
+
+    ensiie::stats::reset();
+    CHECK_THROWS(Quaternion(0, 0, 0, 0).log(), std::invalid_argument);
+    CHECK_THROWS(Quaternion::fromAxisAngle(0, 0, 0, 1), std::invalid_argument);
+    std::vector<double> q(8, 0), out(8);
+    CHECK(quat_normalize(2, q.data(), 4, out.data(), 4, QUAT_LAYOUT_WXYZ) == QUAT_EDOMAIN);
+    s = ensiie::stats::snapshot();
+    CHECK(count(s, Fault::LogarithmOfZero) == 1 && count(s, Fault::NullRotationAxis) == 1);
+    CHECK(count(s, Fault::Domain) == 1 && count(s, Fault::DivisionByZero) == 0);
+}
+
+TEST(stats_kernels_count_no_operations)
+{
+    // The scalar operations used by the kernels, and by their worker threads, are only counted as the kernels.
+    const std::size_t n = 300;
+    std::vector<double> a = quaternions(n), b = quaternions(n + 1), out(4 * n), v(3 * n, 0.5), m(9 * n), s(n, 0.25);
+    quat_normalize(n, a.data(), 4, a.data(), 4, QUAT_LAYOUT_WXYZ);
+    quat_normalize(n, b.data(), 4, b.data(), 4, QUAT_LAYOUT_WXYZ);
+    const double mean[4] = {1, 0, 0, 0};
+    std::vector<Quaternion> rotations(n);
+    ensiie::uniformRotations(1, 0, rotations.data(), n);
+    test::TemporaryDirectory dir("stats_kernels");
+    {
+        std::ofstream f(dir.file("cloud"), std::ios::binary);
+        f.write(reinterpret_cast<const char*>(v.data()), static_cast<std::streamsize>(v.size() * sizeof(double)));
+    }
+    ensiie::PointCloudOptions options;
+    options.format = ensiie::PointFormat::Float64;
+    options.threads = 3;
+    options.tileBytes = 1;
+    ensiie::QuaternionMatrix x(5, 6), y(6, 7), z(5, 7);
+    for (std::size_t i = 0; i < 5; i++)
+    {
+        for (std::size_t j = 0; j < 6; j++)
+        {
+            x.set(i, j, rotations[i * 6 + j]);
+            y.set(j, i, rotations[i * 6 + j + 30]);
+        }
+    }
+    ensiie::FourierPlan plan(12, ensiie::FourierSide::Left, Quaternion(0, 1, 0, 0), 3);
+    std::vector<Quaternion> transform(12);
+    ensiie::BatchMekf filters(n);
+    const double reference[3] = {0, 0, 1};
+
+    ensiie::stats::reset();
+    quat_multiply(n, a.data(), 4, b.data(), 4, out.data(), 4, QUAT_LAYOUT_WXYZ);
+    quat_rotate(n, a.data(), 4, v.data(), 3, v.data(), 3, QUAT_LAYOUT_WXYZ);
+    quat_normalize(n, a.data(), 4, out.data(), 4, QUAT_LAYOUT_WXYZ);
+    quat_slerp(n, a.data(), 4, b.data(), 4, s.data(), 1, out.data(), 4, QUAT_LAYOUT_WXYZ);
+    quat_to_matrix(n, a.data(), 4, m.data(), 9, QUAT_LAYOUT_WXYZ);
+    quat_from_matrix(n, m.data(), 9, out.data(), 4, QUAT_LAYOUT_WXYZ);
+    quat_from_axis_angle(n, v.data(), 3, s.data(), 1, out.data(), 4, QUAT_LAYOUT_WXYZ);
+    quat_random_uniform(1, 0, n, out.data(), 4, QUAT_LAYOUT_WXYZ, QUAT_ACCURACY_EXACT);
+    quat_random_perturbed(mean, 0.1, 1, 0, n, out.data(), 4, QUAT_LAYOUT_WXYZ, QUAT_ACCURACY_EXACT);
+    quat_convert_layout(n, a.data(), 4, QUAT_LAYOUT_WXYZ, out.data(), 4, QUAT_LAYOUT_XYZW);
+    ensiie::rotatePointCloud(dir.file("cloud"), dir.file("rotated"), rotations[0], options);
+    ensiie::rotatePointGroups(dir.file("cloud"), "", rotations.data(), n, 1, options);
+    ensiie::gemm(x, y, z, 2);
+    plan.forward(rotations.data(), transform.data());
+    plan.inverse(transform.data(), transform.data());
+    filters.predict(v.data(), 0.01, 0.1);
+    filters.update(v.data(), reference, 0.1);
+    ensiie::clusterRotations(rotations.data(), n, 0.5, 3);
+    Snapshot snapshot = ensiie::stats::snapshot();
+    CHECK(operations(snapshot) == 0);
+    CHECK(kernel(snapshot, Kernel::Multiply).calls == 1 && kernel(snapshot, Kernel::Multiply).elements == n);
+    CHECK(kernel(snapshot, Kernel::Slerp).calls == 1 && kernel(snapshot, Kernel::RandomPerturbed).calls == 1);
+    CHECK(kernel(snapshot, Kernel::PointCloud).calls == 2 && kernel(snapshot, Kernel::PointCloud).elements == 2 * n);
+    CHECK(kernel(snapshot, Kernel::Gemm).calls == 1 && kernel(snapshot, Kernel::Fourier).calls == 2);
+    CHECK(kernel(snapshot, Kernel::Mekf).calls == 2 && kernel(snapshot, Kernel::Cluster).calls == 1);
+}
+#endif
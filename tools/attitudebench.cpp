@@ -0,0 +1,278 @@
+/**
+ * @file attitudebench.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Measures the contention between one writer and many readers of a shared attitude.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * One thread publishes attitudes, as fast as possible or at a given rate, while the reader threads read them in a
+ * loop. SharedAttitude is compared to an attitude guarded by a std::mutex and by a std::shared_mutex. Every
+ * publication holds the same value in all its fields, so that the readers detect torn reads. For each
+ * implementation and number of readers, the tool reports the reads and writes per second, the failed attempts
+ * of SharedAttitude (retries) and the torn reads, which must be 0.
+ *
+ */
+
+#include "shared_attitude.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    ensiie::Attitude make(double value)
+    {
+        ensiie::Attitude a{ensiie::Quaternion(value, value, value, value)};
+        a.timestamp = value;
+        a.angularVelocity[0] = value;
+        a.angularVelocity[1] = value;
+        a.angularVelocity[2] = value;
+        return a;
+    }
+
+    bool consistent(const ensiie::Attitude& a)
+    {
+        double value = a.timestamp;
+        const ensiie::Quaternion& q = a.orientation;
+        return q.getT() == value && q.getU() == value && q.getV() == value && q.getW() == value &&
+               a.angularVelocity[0] == value && a.angularVelocity[1] == value && a.angularVelocity[2] == value;
+    }
+
+    /**
+     * @brief Lock-free implementation.
+     *
+     */
+    struct Seqlock
+    {
+        ensiie::SharedAttitude shared{make(0)};
+
+        void publish(const ensiie::Attitude& a) { shared.publish(a); }
+
+        bool tryRead(ensiie::Attitude& a) { return shared.tryRead(a); }
+    };
+
+    /**
+     * @brief Implementation with an exclusive lock.
+     *
+     */
+    struct Mutex
+    {
+        std::mutex mutex;
+        ensiie::Attitude attitude = make(0);
+
+        void publish(const ensiie::Attitude& a)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            attitude = a;
+        }
+
+        bool tryRead(ensiie::Attitude& a)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            a = attitude;
+            return true;
+        }
+    };
+
+    /**
+     * @brief Implementation with a readers-writer lock.
+     *
+     */
+    struct SharedMutex
+    {
+        std::shared_mutex mutex;
+        ensiie::Attitude attitude = make(0);
+
+        void publish(const ensiie::Attitude& a)
+        {
+            std::lock_guard<std::shared_mutex> lock(mutex);
+            attitude = a;
+        }
+
+        bool tryRead(ensiie::Attitude& a)
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            a = attitude;
+            return true;
+        }
+    };
+
+    /**
+     * @brief Counters of a reader, on their own cache line.
+     *
+     */
+    struct alignas(64) ReaderCounters
+    {
+        std::uint64_t reads = 0;
+        std::uint64_t retries = 0;
+        std::uint64_t torn = 0;
+    };
+
+    struct Result
+    {
+        double reads;
+        double writes;
+        std::uint64_t retries;
+        std::uint64_t torn;
+    };
+
+    template <class Shared>
+    Result run(std::size_t readers, double seconds, double rate)
+    {
+        Shared shared;
+        std::atomic<bool> stop(false);
+        std::vector<ReaderCounters> counters(readers);
+        std::vector<std::thread> threads;
+        for (std::size_t r = 0; r < readers; r++)
+        {
+            threads.emplace_back([&shared, &stop, &c = counters[r]]()
+                                 {
+                                     ensiie::Attitude a;
+                                     while (!stop.load(std::memory_order_relaxed))
+                                     {
+                                         if (!shared.tryRead(a))
+                                         {
+                                             c.retries++;
+                                             continue;
+                                         }
+                                         c.reads++;
+                                         if (!consistent(a))
+                                         {
+                                             c.torn++;
+                                         }
+                                     } });
+        }
+        auto start = std::chrono::steady_clock::now();
+        auto end = start + std::chrono::duration<double>(seconds);
+        std::chrono::duration<double> period(rate > 0 ? 1 / rate : 0);
+        std::uint64_t writes = 0;
+        for (auto now = start; now < end; now = std::chrono::steady_clock::now())
+        {
+            shared.publish(make(static_cast<double>(++writes)));
+            if (rate > 0)
+            {
+                std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(writes * period));
+            }
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stop.store(true, std::memory_order_relaxed);
+        for (std::thread& t : threads)
+        {
+            t.join();
+        }
+        Result result{0, writes / elapsed, 0, 0};
+        for (const ReaderCounters& c : counters)
+        {
+            result.reads += c.reads;
+            result.retries += c.retries;
+            result.torn += c.torn;
+        }
+        result.reads /= elapsed;
+        return result;
+    }
+
+    struct Options
+    {
+        std::size_t readers = 0;
+        double seconds = 0.5;
+        double rate = 0;
+    };
+
+    void usage()
+    {
+        std::fprintf(stderr,
+                     "Usage: attitudebench [options]\n"
+                     "Options:\n"
+                     "  --readers N      Largest number of readers, doubled from 1 (default: hardware threads - 1).\n"
+                     "  --time SECONDS   Duration of each measure (default 0.5).\n"
+                     "  --rate HZ        Publications per second, 0 for as fast as possible (default 0).\n");
+    }
+
+    Options parseOptions(int argc, char** argv)
+    {
+        Options o;
+        for (int i = 1; i < argc; i++)
+        {
+            std::string a = argv[i];
+            if (a == "-h" || a == "--help")
+            {
+                usage();
+                std::exit(0);
+            }
+            if (i + 1 >= argc)
+            {
+                throw std::invalid_argument("Unknown option or missing value: " + a);
+            }
+            std::string value = argv[++i];
+            if (a == "--readers")
+            {
+                o.readers = std::stoull(value);
+            }
+            else if (a == "--time")
+            {
+                o.seconds = std::stod(value);
+            }
+            else if (a == "--rate")
+            {
+                o.rate = std::stod(value);
+            }
+            else
+            {
+                throw std::invalid_argument("Unknown option: " + a);
+            }
+        }
+        if (o.readers == 0)
+        {
+            unsigned int hardware = std::thread::hardware_concurrency();
+            o.readers = hardware > 1 ? hardware - 1 : 1;
+        }
+        if (o.seconds <= 0 || o.rate < 0)
+        {
+            throw std::invalid_argument("The time must be positive and the rate non-negative");
+        }
+        return o;
+    }
+
+    template <class Shared>
+    void report(const char* name, const Options& o)
+    {
+        for (std::size_t readers = 1;; readers = readers * 2 < o.readers ? readers * 2 : o.readers)
+        {
+            Result r = run<Shared>(readers, o.seconds, o.rate);
+            std::printf("%-14s %8zu %14.4g %14.4g %14.4g %12llu %8llu\n", name, readers, r.reads, r.reads / readers,
+                        r.writes, static_cast<unsigned long long>(r.retries), static_cast<unsigned long long>(r.torn));
+            if (readers == o.readers)
+            {
+                break;
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        Options o = parseOptions(argc, argv);
+        std::printf("%-14s %8s %14s %14s %14s %12s %8s\n", "implementation", "readers", "reads/s", "reads/s/reader",
+                    "writes/s", "retries", "torn");
+        report<Seqlock>("seqlock", o);
+        report<SharedMutex>("shared_mutex", o);
+        report<Mutex>("mutex", o);
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "attitudebench: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,1101 @@
+/**
+ * @file quatbench.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Measures the accuracy and the speed of the operations against an extended-precision reference.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * The scalar operations, the batch kernels of the C interface, the codecs, the random rotations (Philox and
+ * Shoemake), the matrix product, the Fourier transforms of signals, the point cloud files, and the operations of
+ * the template version are run on classes of random and adversarial inputs. exp and log only have scalar versions.
+ * The results are compared to the same operation computed in long double from the same inputs:
+ * - ULP: the largest component error, in units in the last place of a double at the scale of the largest
+ *   component of the reference (float results are also counted in double ULPs),
+ * - angle: for rotations, the angle of the rotation between the result and the reference,
+ * - failures: exceptions and non-finite results where the reference is finite,
+ * - compared: results compared, the others being failures or having no finite reference (overflows),
+ * - throughput: millions of operations per second on one thread,
+ * - check: whether the errors are within the bounds of the case, "-" when unchecked. quatbench exits with 1 when
+ *   a result exceeds its bounds.
+ *
+ */
+
+#include "pointcloud.h"
+#include "quaternion.h"
+#include "quaternion_c.h"
+#include "quaternion_codec.h"
+#include "quaternion_fourier.h"
+#include "quaternion_matrix.h"
+#include "quaternion_random.h"
+#include "quatbench_template.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+    using Real = long double;
+
+    /**
+     * @brief A quaternion of the reference.
+     *
+     */
+    struct Ref
+    {
+        Real t, u, v, w;
+    };
+
+    Ref load(const double* p)
+    {
+        return Ref{p[0], p[1], p[2], p[3]};
+    }
+
+    Ref operator*(const Ref& a, const Ref& b)
+    {
+        return Ref{a.t * b.t - a.u * b.u - a.v * b.v - a.w * b.w, a.t * b.u + a.u * b.t + a.v * b.w - a.w * b.v,
+                   a.t * b.v - a.u * b.w + a.v * b.t + a.w * b.u, a.t * b.w + a.u * b.v - a.v * b.u + a.w * b.t};
+    }
+
+    Ref operator*(const Ref& a, Real k)
+    {
+        return Ref{a.t * k, a.u * k, a.v * k, a.w * k};
+    }
+
+    Ref operator+(const Ref& a, const Ref& b)
+    {
+        return Ref{a.t + b.t, a.u + b.u, a.v + b.v, a.w + b.w};
+    }
+
+    Real dot(const Ref& a, const Ref& b)
+    {
+        return a.t * b.t + a.u * b.u + a.v * b.v + a.w * b.w;
+    }
+
+    Real norm(const Ref& a)
+    {
+        return std::sqrt(dot(a, a));
+    }
+
+    Ref conjugate(const Ref& a)
+    {
+        return Ref{a.t, -a.u, -a.v, -a.w};
+    }
+
+    Ref inverse(const Ref& a)
+    {
+        return conjugate(a) * (1 / dot(a, a));
+    }
+
+    Ref normalize(const Ref& a)
+    {
+        return a * (1 / norm(a));
+    }
+
+    Ref exp(const Ref& a)
+    {
+        Real n = std::sqrt(a.u * a.u + a.v * a.v + a.w * a.w);
+        Real k = n == 0 ? 1 : std::sin(n) / n;
+        Real e = std::exp(a.t);
+        return Ref{e * std::cos(n), e * k * a.u, e * k * a.v, e * k * a.w};
+    }
+
+    Ref log(const Ref& a)
+    {
+        Real n = std::sqrt(a.u * a.u + a.v * a.v + a.w * a.w);
+        Real k = n == 0 ? 0 : std::atan2(n, a.t) / n;
+        return Ref{std::log(norm(a)), k * a.u, k * a.v, k * a.w};
+    }
+
+    Ref slerp(const Ref& a, Ref b, Real s)
+    {
+        Real d = dot(a, b);
+        if (d < 0)
+        {
+            b = b * -1;
+            d = -d;
+        }
+        // The angle from the chord is accurate for close quaternions, where acos is not.
+        Ref chord = b + a * -1;
+        Real theta = 2 * std::asin(std::min<Real>(1, norm(chord) / 2));
+        if (theta == 0)
+        {
+            return a;
+        }
+        return a * (std::sin((1 - s) * theta) / std::sin(theta)) + b * (std::sin(s * theta) / std::sin(theta));
+    }
+
+    Ref fromAxisAngle(const double* v, Real angle)
+    {
+        Real n = std::sqrt(Real(v[0]) * v[0] + Real(v[1]) * v[1] + Real(v[2]) * v[2]);
+        Real s = std::sin(angle / 2) / n;
+        return Ref{std::cos(angle / 2), s * v[0], s * v[1], s * v[2]};
+    }
+
+    void toMatrix(const Ref& q, Real m[9])
+    {
+        Ref r = normalize(q);
+        Real t = r.t, u = r.u, v = r.v, w = r.w;
+        m[0] = 1 - 2 * (v * v + w * w);
+        m[1] = 2 * (u * v - t * w);
+        m[2] = 2 * (u * w + t * v);
+        m[3] = 2 * (u * v + t * w);
+        m[4] = 1 - 2 * (u * u + w * w);
+        m[5] = 2 * (v * w - t * u);
+        m[6] = 2 * (u * w - t * v);
+        m[7] = 2 * (v * w + t * u);
+        m[8] = 1 - 2 * (u * u + v * v);
+    }
+
+    Ref fromMatrix(const double* m)
+    {
+        Real trace = Real(m[0]) + m[4] + m[8];
+        Ref q;
+        if (trace > 0)
+        {
+            Real s = 2 * std::sqrt(trace + 1);
+            q = Ref{s / 4, (Real(m[7]) - m[5]) / s, (Real(m[2]) - m[6]) / s, (Real(m[3]) - m[1]) / s};
+        }
+        else if (m[0] > m[4] && m[0] > m[8])
+        {
+            Real s = 2 * std::sqrt(1 + Real(m[0]) - m[4] - m[8]);
+            q = Ref{(Real(m[7]) - m[5]) / s, s / 4, (Real(m[1]) + m[3]) / s, (Real(m[2]) + m[6]) / s};
+        }
+        else if (m[4] > m[8])
+        {
+            Real s = 2 * std::sqrt(1 + Real(m[4]) - m[0] - m[8]);
+            q = Ref{(Real(m[2]) - m[6]) / s, (Real(m[1]) + m[3]) / s, s / 4, (Real(m[5]) + m[7]) / s};
+        }
+        else
+        {
+            Real s = 2 * std::sqrt(1 + Real(m[8]) - m[0] - m[4]);
+            q = Ref{(Real(m[3]) - m[1]) / s, (Real(m[2]) + m[6]) / s, (Real(m[5]) + m[7]) / s, s / 4};
+        }
+        return normalize(q);
+    }
+
+    void rotate(const Ref& q, const double* p, Real out[3])
+    {
+        Ref r = q * Ref{0, p[0], p[1], p[2]} * inverse(q);
+        out[0] = r.u;
+        out[1] = r.v;
+        out[2] = r.w;
+    }
+
+    /**
+     * @brief The uniform numbers of block j of draw k of a seed, from Philox4x32-10 as in quaternion_random.cpp:
+     * 53 bits from the first two words, then 32 bits from each of the last two.
+     *
+     */
+    void uniforms(std::uint64_t seed, std::uint64_t k, std::uint32_t j, Real u[3])
+    {
+        std::uint32_t c[4] = {static_cast<std::uint32_t>(k), static_cast<std::uint32_t>(k >> 32), j, 0};
+        std::uint32_t k0 = static_cast<std::uint32_t>(seed), k1 = static_cast<std::uint32_t>(seed >> 32);
+        for (int r = 0; r < 10; r++)
+        {
+            std::uint64_t p0 = std::uint64_t(0xD2511F53) * c[0];
+            std::uint64_t p1 = std::uint64_t(0xCD9E8D57) * c[2];
+            std::uint32_t next[4] = {static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k0, static_cast<std::uint32_t>(p1),
+                                     static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k1, static_cast<std::uint32_t>(p0)};
+            std::copy(next, next + 4, c);
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+        std::uint64_t a = c[0] | (std::uint64_t(c[1]) << 32);
+        u[0] = std::ldexp(static_cast<Real>(a >> 11), -53);
+        u[1] = std::ldexp(static_cast<Real>(c[2]), -32);
+        u[2] = std::ldexp(static_cast<Real>(c[3]), -32);
+    }
+
+    const Real TWO_PI = 2 * std::acos(Real(-1));
+
+    /**
+     * @brief Draw k of uniformRotations(): Shoemake's method, from one block.
+     *
+     */
+    Ref uniformRotation(std::uint64_t seed, std::uint64_t k)
+    {
+        Real u[3];
+        uniforms(seed, k, 0, u);
+        Real r1 = std::sqrt(1 - u[0]), r2 = std::sqrt(u[0]);
+        return Ref{r2 * std::cos(TWO_PI * u[2]), r1 * std::sin(TWO_PI * u[1]), r1 * std::cos(TWO_PI * u[1]),
+                   r2 * std::sin(TWO_PI * u[2])};
+    }
+
+    /**
+     * @brief Draw k of perturbedRotations(): mean * exp(v / 2), v drawn with Box-Muller, a radius and an angle from
+     * each of two blocks.
+     *
+     */
+    Ref perturbedRotation(const Ref& mean, Real sigma, std::uint64_t seed, std::uint64_t k)
+    {
+        Real a[3], b[3];
+        uniforms(seed, k, 0, a);
+        uniforms(seed, k, 1, b);
+        Real ra = sigma * std::sqrt(-2 * std::log(1 - a[0])), rb = sigma * std::sqrt(-2 * std::log(1 - b[0]));
+        Ref half{0, ra * std::cos(TWO_PI * a[1]) / 2, ra * std::sin(TWO_PI * a[1]) / 2, rb * std::cos(TWO_PI * b[1]) / 2};
+        return mean * exp(half);
+    }
+
+    void store(const Ref& q, Real* out)
+    {
+        out[0] = q.t;
+        out[1] = q.u;
+        out[2] = q.v;
+        out[3] = q.w;
+    }
+
+    /**
+     * @brief Kind of the results of an operation.
+     *
+     */
+    enum class Output
+    {
+        Quaternion,
+        Rotation,
+        Scalar,
+        Vector,
+        Matrix
+    };
+
+    int width(Output o)
+    {
+        switch (o)
+        {
+        case Output::Scalar:
+            return 1;
+        case Output::Vector:
+            return 3;
+        case Output::Matrix:
+            return 9;
+        default:
+            return 4;
+        }
+    }
+
+    /**
+     * @brief A class of inputs: quaternions a and b, vectors v, slerp parameters s, angles, and matrices m of a.
+     *
+     */
+    struct Inputs
+    {
+        std::string name;
+        bool unit = false;
+        std::size_t n = 0;
+        std::vector<double> a, b, v, s, angle, m;
+    };
+
+    /**
+     * @brief An implementation of an operation and its reference.
+     *
+     */
+    struct Case
+    {
+        std::string operation;
+        std::string implementation;
+        Output output;
+        bool unitOnly;
+        std::function<void(const Inputs&, double*)> run;
+        std::function<void(const Inputs&, std::size_t, Real*)> reference;
+    };
+
+    struct Options
+    {
+        std::size_t n = 100000;
+        std::uint64_t seed = 1;
+        double time = 0.05;
+        std::string filter;
+    };
+
+    void usage()
+    {
+        std::fprintf(stderr,
+                     "Usage: quatbench [options]\n"
+                     "Options:\n"
+                     "  -n N             Inputs per class (default 100000).\n"
+                     "  --seed N         Seed of the inputs (default 1).\n"
+                     "  --time SECONDS   Minimum duration of each throughput measure (default 0.05).\n"
+                     "  --filter TEXT    Only the operations or implementations containing TEXT.\n");
+    }
+
+    Options parseOptions(int argc, char** argv)
+    {
+        Options o;
+        for (int i = 1; i < argc; i++)
+        {
+            std::string a = argv[i];
+            if (a == "-h" || a == "--help")
+            {
+                usage();
+                std::exit(0);
+            }
+            if (i + 1 >= argc)
+            {
+                throw std::invalid_argument("Unknown option or missing value: " + a);
+            }
+            std::string value = argv[++i];
+            if (a == "-n")
+            {
+                o.n = std::stoull(value);
+            }
+            else if (a == "--seed")
+            {
+                o.seed = std::stoull(value);
+            }
+            else if (a == "--time")
+            {
+                o.time = std::stod(value);
+            }
+            else if (a == "--filter")
+            {
+                o.filter = value;
+            }
+            else
+            {
+                throw std::invalid_argument("Unknown option: " + a);
+            }
+        }
+        if (o.n == 0)
+        {
+            throw std::invalid_argument("-n must be positive");
+        }
+        return o;
+    }
+
+    /**
+     * @brief Rotates the unit quaternion q by a random rotation of the given angle.
+     *
+     */
+    void perturb(const double* q, double angle, std::mt19937_64& g, double* out)
+    {
+        std::normal_distribution<double> normal;
+        ensiie::Quaternion r = ensiie::Quaternion::fromAxisAngle(normal(g), normal(g), normal(g), angle);
+        ensiie::Quaternion p = (ensiie::Quaternion(q[0], q[1], q[2], q[3]) * r).normalize();
+        out[0] = p.getT();
+        out[1] = p.getU();
+        out[2] = p.getV();
+        out[3] = p.getW();
+    }
+
+    /**
+     * @brief Generates a class of inputs.
+     *
+     * random: components in [-1, 1]. unit: uniform rotations. tiny: norms around 1e-12. huge: norms around
+     * 1e150 and angles up to 1e5. antipodal: b close to -a. close: b within 0.1 rad of a, around the threshold of slerp.
+     */
+    Inputs generate(const std::string& name, std::size_t n, std::uint64_t seed)
+    {
+        std::mt19937_64 g(seed);
+        std::uniform_real_distribution<double> uniform(-1, 1);
+        std::uniform_real_distribution<double> unitInterval(0, 1);
+        std::normal_distribution<double> normal;
+        Inputs in;
+        in.name = name;
+        in.n = n;
+        in.unit = name == "unit" || name == "antipodal" || name == "close";
+        in.a.resize(4 * n);
+        in.b.resize(4 * n);
+        in.v.resize(3 * n);
+        in.s.resize(n);
+        in.angle.resize(n);
+        in.m.resize(9 * n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            double* a = &in.a[4 * i];
+            double* b = &in.b[4 * i];
+            double* v = &in.v[3 * i];
+            double scale = 1;
+            if (name == "tiny")
+            {
+                scale = std::ldexp(1.0, -40 - static_cast<int>(g() % 8));
+            }
+            else if (name == "huge")
+            {
+                scale = std::ldexp(1.0, 496 + static_cast<int>(g() % 8));
+            }
+            for (int k = 0; k < 4; k++)
+            {
+                a[k] = (in.unit ? normal(g) : uniform(g)) * scale;
+                b[k] = (in.unit ? normal(g) : uniform(g)) * scale;
+            }
+            for (int k = 0; k < 3; k++)
+            {
+                v[k] = uniform(g) * scale;
+            }
+            if (in.unit)
+            {
+                ensiie::Quaternion p = ensiie::Quaternion(a[0], a[1], a[2], a[3]).normalize();
+                double q[4] = {p.getT(), p.getU(), p.getV(), p.getW()};
+                for (int k = 0; k < 4; k++)
+                {
+                    a[k] = q[k];
+                }
+                if (name == "antipodal")
+                {
+                    double minus[4] = {-q[0], -q[1], -q[2], -q[3]};
+                    perturb(minus, 1e-7 * unitInterval(g), g, b);
+                }
+                else if (name == "close")
+                {
+                    perturb(q, 0.1 * std::pow(unitInterval(g), 4), g, b);
+                }
+                else
+                {
+                    ensiie::Quaternion r = ensiie::Quaternion(b[0], b[1], b[2], b[3]).normalize();
+                    b[0] = r.getT();
+                    b[1] = r.getU();
+                    b[2] = r.getV();
+                    b[3] = r.getW();
+                }
+                ensiie::Quaternion(q[0], q[1], q[2], q[3]).toMatrix(&in.m[9 * i]);
+            }
+            in.s[i] = unitInterval(g);
+            in.angle[i] = name == "huge" ? 1e5 * uniform(g) : (name == "tiny" ? 1e-9 * uniform(g) : 3.14159265358979 * uniform(g));
+        }
+        return in;
+    }
+
+    /**
+     * @brief Depth of the matrix products.
+     *
+     */
+    constexpr std::size_t GEMM_DEPTH = 8;
+
+    /**
+     * @brief Standard deviation of the rotation vectors of the perturbed rotations.
+     *
+     */
+    constexpr double SIGMA = 0.1;
+
+    /**
+     * @brief Seed of the random rotations of a class of inputs.
+     *
+     */
+    std::uint64_t seedOf(const Inputs& in)
+    {
+        std::uint64_t h = 0;
+        for (char c : in.name)
+        {
+            h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3;
+        }
+        return h;
+    }
+
+    ensiie::Quaternion quaternion(const std::vector<double>& x, std::size_t i)
+    {
+        return ensiie::Quaternion(x[4 * i], x[4 * i + 1], x[4 * i + 2], x[4 * i + 3]);
+    }
+
+    void put(const ensiie::Quaternion& q, double* out)
+    {
+        out[0] = q.getT();
+        out[1] = q.getU();
+        out[2] = q.getV();
+        out[3] = q.getW();
+    }
+
+    /**
+     * @brief Runs a scalar operation on every input, writing NaN when it throws.
+     *
+     */
+    template <typename Operation>
+    void each(const Inputs& in, double* out, int width, Operation operation)
+    {
+        for (std::size_t i = 0; i < in.n; i++)
+        {
+            try
+            {
+                operation(i, out + width * i);
+            }
+            catch (const std::exception&)
+            {
+                for (int k = 0; k < width; k++)
+                {
+                    out[width * i + k] = std::numeric_limits<double>::quiet_NaN();
+                }
+            }
+        }
+    }
+
+    std::vector<Case> cases()
+    {
+        using ensiie::Accuracy;
+        using ensiie::Quaternion;
+        std::vector<Case> c;
+        auto quaternionCase = [&](const std::string& op, const std::string& impl, Output output, bool unitOnly,
+                                  std::function<void(const Inputs&, double*)> run,
+                                  std::function<void(const Inputs&, std::size_t, Real*)> reference) {
+            c.push_back(Case{op, impl, output, unitOnly, run, reference});
+        };
+
+        auto refMultiply = [](const Inputs& in, std::size_t i, Real* r) { store(load(&in.a[4 * i]) * load(&in.b[4 * i]), r); };
+        // The library divides on the left: a / b = b^-1 a.
+        auto refDivide = [](const Inputs& in, std::size_t i, Real* r) { store(inverse(load(&in.b[4 * i])) * load(&in.a[4 * i]), r); };
+        auto refInverse = [](const Inputs& in, std::size_t i, Real* r) { store(inverse(load(&in.a[4 * i])), r); };
+        auto refNorm = [](const Inputs& in, std::size_t i, Real* r) { *r = norm(load(&in.a[4 * i])); };
+        auto refNormalize = [](const Inputs& in, std::size_t i, Real* r) { store(normalize(load(&in.a[4 * i])), r); };
+        auto refSlerp = [](const Inputs& in, std::size_t i, Real* r) {
+            store(slerp(load(&in.a[4 * i]), load(&in.b[4 * i]), in.s[i]), r);
+        };
+        auto refAxisAngle = [](const Inputs& in, std::size_t i, Real* r) { store(fromAxisAngle(&in.v[3 * i], in.angle[i]), r); };
+        auto refRotate = [](const Inputs& in, std::size_t i, Real* r) { rotate(load(&in.a[4 * i]), &in.v[3 * i], r); };
+        auto refToMatrix = [](const Inputs& in, std::size_t i, Real* r) { toMatrix(load(&in.a[4 * i]), r); };
+        auto refFromMatrix = [](const Inputs& in, std::size_t i, Real* r) { store(fromMatrix(&in.m[9 * i]), r); };
+        auto refSame = [](const Inputs& in, std::size_t i, Real* r) { store(load(&in.a[4 * i]), r); };
+
+        // Scalar operations of the double version.
+        quaternionCase("multiply", "double", Output::Quaternion, false, [](const Inputs& in, double* out) {
+            each(in, out, 4, [&](std::size_t i, double* o) { put(quaternion(in.a, i) * quaternion(in.b, i), o); });
+        }, refMultiply);
+        quaternionCase("divide", "double", Output::Quaternion, false, [](const Inputs& in, double* out) {
+            each(in, out, 4, [&](std::size_t i, double* o) { put(quaternion(in.a, i) / quaternion(in.b, i), o); });
+        }, refDivide);
+        quaternionCase("inverse", "double", Output::Quaternion, false, [](const Inputs& in, double* out) {
+            each(in, out, 4, [&](std::size_t i, double* o) { put(quaternion(in.a, i).inverse(), o); });
+        }, refInverse);
+        quaternionCase("norm", "double", Output::Scalar, false, [](const Inputs& in, double* out) {
+            each(in, out, 1, [&](std::size_t i, double* o) { *o = quaternion(in.a, i).norm(); });
+        }, refNorm);
+        quaternionCase("normalize", "double", Output::Rotation, false, [](const Inputs& in, double* out) {
+            each(in, out, 4, [&](std::size_t i, double* o) { put(quaternion(in.a, i).normalize(), o); });
+        }, refNormalize);
+        quaternionCase("rotate", "double", Output::Vector, true, [](const Inputs& in, double* out) {
+            each(in, out, 3, [&](std::size_t i, double* o) {
+                o[0] = in.v[3 * i];
+                o[1] = in.v[3 * i + 1];
+                o[2] = in.v[3 * i + 2];
+                quaternion(in.a, i).rotate(o[0], o[1], o[2]);
+            });
+        }, refRotate);
+        quaternionCase("to_matrix", "double", Output::Matrix, true, [](const Inputs& in, double* out) {
+            each(in, out, 9, [&](std::size_t i, double* o) { quaternion(in.a, i).toMatrix(o); });
+        }, refToMatrix);
+        quaternionCase("from_matrix", "double", Output::Rotation, true, [](const Inputs& in, double* out) {
+            each(in, out, 4, [&](std::size_t i, double* o) { put(Quaternion::fromMatrix(&in.m[9 * i]), o); });
+        }, refFromMatrix);
+
+        const std::pair<Accuracy, std::string> accuracies[] = {
+            {Accuracy::Exact, "exact"}, {Accuracy::Ulp, "ulp"}, {Accuracy::Fast, "fast"}};
+        for (const auto& [accuracy, label] : accuracies)
+        {
+            Accuracy x = accuracy;
+            quaternionCase("exp", "double " + label, Output::Quaternion, false, [x](const Inputs& in, double* out) {
+                each(in, out, 4, [&](std::size_t i, double* o) { put(quaternion(in.a, i).exp(x), o); });
+            }, [](const Inputs& in, std::size_t i, Real* r) { store(exp(load(&in.a[4 * i])), r); });
+            quaternionCase("log", "double " + label, Output::Quaternion, false, [x](const Inputs& in, double* out) {
+                each(in, out, 4, [&](std::size_t i, double* o) { put(quaternion(in.a, i).log(x), o); });
+            }, [](const Inputs& in, std::size_t i, Real* r) { store(log(load(&in.a[4 * i])), r); });
+            quaternionCase("slerp", "double " + label, Output::Rotation, true, [x](const Inputs& in, double* out) {
+                each(in, out, 4, [&](std::size_t i, double* o) {
+                    put(Quaternion::slerp(quaternion(in.a, i), quaternion(in.b, i), in.s[i], x), o);
+                });
+            }, refSlerp);
+            quaternionCase("from_axis_angle", "double " + label, Output::Rotation, false, [x](const Inputs& in, double* out) {
+                each(in, out, 4, [&](std::size_t i, double* o) {
+                    put(Quaternion::fromAxisAngle(in.v[3 * i], in.v[3 * i + 1], in.v[3 * i + 2], in.angle[i], x), o);
+                });
+            }, refAxisAngle);
+        }
+
+        // Batch kernels of the C interface, on WXYZ arrays.
+        quaternionCase("multiply", "c batch", Output::Quaternion, false, [](const Inputs& in, double* out) {
+            quat_multiply(in.n, in.a.data(), 4, in.b.data(), 4, out, 4, QUAT_LAYOUT_WXYZ);
+        }, refMultiply);
+        quaternionCase("normalize", "c batch", Output::Rotation, false, [](const Inputs& in, double* out) {
+            if (quat_normalize(in.n, in.a.data(), 4, out, 4, QUAT_LAYOUT_WXYZ) == QUAT_EDOMAIN)
+            {
+                // The null quaternions, copied unchanged, are failures as the exceptions of the scalar version.
+                for (std::size_t i = 0; i < in.n; i++)
+                {
+                    if (quaternion(in.a, i).norm() <= 1e-15)
+                    {
+                        std::fill(out + 4 * i, out + 4 * i + 4, std::numeric_limits<double>::quiet_NaN());
+                    }
+                }
+            }
+        }, refNormalize);
+        quaternionCase("rotate", "c batch", Output::Vector, true, [](const Inputs& in, double* out) {
+            quat_rotate(in.n, in.a.data(), 4, in.v.data(), 3, out, 3, QUAT_LAYOUT_WXYZ);
+        }, refRotate);
+        quaternionCase("to_matrix", "c batch", Output::Matrix, true, [](const Inputs& in, double* out) {
+            quat_to_matrix(in.n, in.a.data(), 4, out, 9, QUAT_LAYOUT_WXYZ);
+        }, refToMatrix);
+        quaternionCase("from_matrix", "c batch", Output::Rotation, true, [](const Inputs& in, double* out) {
+            quat_from_matrix(in.n, in.m.data(), 9, out, 4, QUAT_LAYOUT_WXYZ);
+        }, refFromMatrix);
+        const std::pair<int, std::string> levels[] = {
+            {QUAT_ACCURACY_EXACT, "exact"}, {QUAT_ACCURACY_ULP, "ulp"}, {QUAT_ACCURACY_FAST, "fast"}};
+        for (const auto& [level, label] : levels)
+        {
+            int x = level;
+            quaternionCase("slerp", "c batch " + label, Output::Rotation, true, [x](const Inputs& in, double* out) {
+                quat_slerp_ex(in.n, in.a.data(), 4, in.b.data(), 4, in.s.data(), 1, out, 4, QUAT_LAYOUT_WXYZ, x);
+            }, refSlerp);
+            quaternionCase("from_axis_angle", "c batch " + label, Output::Rotation, false, [x](const Inputs& in, double* out) {
+                if (quat_from_axis_angle_ex(in.n, in.v.data(), 3, in.angle.data(), 1, out, 4, QUAT_LAYOUT_WXYZ, x) == QUAT_EDOMAIN)
+                {
+                    // The identities written for the null axes are failures, as the exceptions of the scalar version.
+                    for (std::size_t i = 0; i < in.n; i++)
+                    {
+                        const double* v = &in.v[3 * i];
+                        if (v[0] * v[0] + v[1] * v[1] + v[2] * v[2] <= 1e-30)
+                        {
+                            std::fill(out + 4 * i, out + 4 * i + 4, std::numeric_limits<double>::quiet_NaN());
+                        }
+                    }
+                }
+            }, refAxisAngle);
+        }
+
+        // Lossy codecs: the error of an encode-decode round trip.
+        quaternionCase("codec", "32 bits", Output::Rotation, true, [](const Inputs& in, double* out) {
+            std::vector<Quaternion> q(in.n), r(in.n);
+            std::vector<std::uint32_t> x(in.n);
+            for (std::size_t i = 0; i < in.n; i++)
+            {
+                q[i] = quaternion(in.a, i);
+            }
+            ensiie::codec::encode32(q.data(), x.data(), in.n);
+            ensiie::codec::decode32(x.data(), r.data(), in.n);
+            for (std::size_t i = 0; i < in.n; i++)
+            {
+                put(r[i], out + 4 * i);
+            }
+        }, refSame);
+        quaternionCase("codec", "48 bits", Output::Rotation, true, [](const Inputs& in, double* out) {
+            std::vector<Quaternion> q(in.n), r(in.n);
+            std::vector<ensiie::Packed48> x(in.n);
+            for (std::size_t i = 0; i < in.n; i++)
+            {
+                q[i] = quaternion(in.a, i);
+            }
+            ensiie::codec::encode48(q.data(), x.data(), in.n);
+            ensiie::codec::decode48(x.data(), r.data(), in.n);
+            for (std::size_t i = 0; i < in.n; i++)
+            {
+                put(r[i], out + 4 * i);
+            }
+        }, refSame);
+        quaternionCase("codec", "64 bits", Output::Rotation, true, [](const Inputs& in, double* out) {
+            std::vector<Quaternion> q(in.n), r(in.n);
+            std::vector<std::uint64_t> x(in.n);
+            for (std::size_t i = 0; i < in.n; i++)
+            {
+                q[i] = quaternion(in.a, i);
+            }
+            ensiie::codec::encode64(q.data(), x.data(), in.n);
+            ensiie::codec::decode64(x.data(), r.data(), in.n);
+            for (std::size_t i = 0; i < in.n; i++)
+            {
+                put(r[i], out + 4 * i);
+            }
+        }, refSame);
+
+        // Random rotations, drawn from a seed that depends on the class of inputs.
+        for (const auto& [accuracy, label] : accuracies)
+        {
+            Accuracy x = accuracy;
+            quaternionCase("random_uniform", "double " + label, Output::Rotation, true, [x](const Inputs& in, double* out) {
+                std::vector<Quaternion> q(in.n);
+                ensiie::uniformRotations(seedOf(in), 0, q.data(), in.n, x);
+                for (std::size_t i = 0; i < in.n; i++)
+                {
+                    put(q[i], out + 4 * i);
+                }
+            }, [](const Inputs& in, std::size_t i, Real* r) { store(uniformRotation(seedOf(in), i), r); });
+            quaternionCase("random_perturbed", "double " + label, Output::Rotation, true, [x](const Inputs& in, double* out) {
+                std::vector<Quaternion> q(in.n);
+                ensiie::perturbedRotations(quaternion(in.a, 0), SIGMA, seedOf(in), 0, q.data(), in.n, x);
+                for (std::size_t i = 0; i < in.n; i++)
+                {
+                    put(q[i], out + 4 * i);
+                }
+            }, [](const Inputs& in, std::size_t i, Real* r) {
+                store(perturbedRotation(load(&in.a[0]), SIGMA, seedOf(in), i), r);
+            });
+        }
+
+        // Matrix products: output i is c(i / GEMM_DEPTH, i % GEMM_DEPTH) of a(r, k) = a[(GEMM_DEPTH r + k) % n]
+        // times b(k, j) = b[(GEMM_DEPTH k + j) % n], on one thread.
+        quaternionCase("gemm", "depth 8", Output::Quaternion, false, [](const Inputs& in, double* out) {
+            std::size_t rows = (in.n + GEMM_DEPTH - 1) / GEMM_DEPTH;
+            ensiie::QuaternionMatrix a(rows, GEMM_DEPTH), b(GEMM_DEPTH, GEMM_DEPTH), c(rows, GEMM_DEPTH);
+            for (int p = 0; p < 4; p++)
+            {
+                for (std::size_t k = 0; k < rows * GEMM_DEPTH; k++)
+                {
+                    a.plane(p)[k] = in.a[4 * (k % in.n) + p];
+                }
+                for (std::size_t k = 0; k < GEMM_DEPTH * GEMM_DEPTH; k++)
+                {
+                    b.plane(p)[k] = in.b[4 * (k % in.n) + p];
+                }
+            }
+            ensiie::gemm(a, b, c, 1);
+            for (std::size_t i = 0; i < in.n; i++)
+            {
+                for (int p = 0; p < 4; p++)
+                {
+                    out[4 * i + p] = c.plane(p)[i];
+                }
+            }
+        }, [](const Inputs& in, std::size_t i, Real* r) {
+            Ref sum{0, 0, 0, 0};
+            for (std::size_t k = 0; k < GEMM_DEPTH; k++)
+            {
+                sum = sum + load(&in.a[4 * ((i / GEMM_DEPTH * GEMM_DEPTH + k) % in.n)]) *
+                                load(&in.b[4 * ((k * GEMM_DEPTH + i % GEMM_DEPTH) % in.n)]);
+            }
+            store(sum, r);
+        });
+
+        // Quaternion Fourier transforms of consecutive signals, signal s being a[(length s + x) % n], on one thread:
+        // a power of 2 (radix-2 FFT) and another length (Bluestein's algorithm).
+        const std::tuple<ensiie::FourierSide, std::string, std::size_t> transforms[] = {
+            {ensiie::FourierSide::Left, "left 64", 64}, {ensiie::FourierSide::Right, "right 60", 60}};
+        for (const auto& [side, label, length] : transforms)
+        {
+            ensiie::FourierSide d = side;
+            std::size_t l = length;
+            quaternionCase("qft", label, Output::Quaternion, false, [d, l](const Inputs& in, double* out) {
+                std::vector<Quaternion> f((in.n + l - 1) / l * l);
+                for (std::size_t k = 0; k < f.size(); k++)
+                {
+                    f[k] = quaternion(in.a, k % in.n);
+                }
+                ensiie::FourierPlan plan(l, d, Quaternion(0, 1, 2, 2), 1);
+                plan.forward(f.data(), f.data(), f.size() / l);
+                for (std::size_t i = 0; i < in.n; i++)
+                {
+                    put(f[i], out + 4 * i);
+                }
+            }, [d, l](const Inputs& in, std::size_t i, Real* r) {
+                // F(u) = sum of exp(-mu 2 pi u x / l) f(x), or f(x) exp(-mu 2 pi u x / l) on the right.
+                std::size_t first = i / l * l, u = i % l;
+                Ref sum{0, 0, 0, 0};
+                for (std::size_t x = 0; x < l; x++)
+                {
+                    Real angle = TWO_PI * static_cast<Real>(u * x % l) / static_cast<Real>(l);
+                    Real sine = std::sin(angle) / 3;
+                    Ref e{std::cos(angle), -sine, -2 * sine, -2 * sine};
+                    Ref f = load(&in.a[4 * ((first + x) % in.n)]);
+                    sum = sum + (d == ensiie::FourierSide::Left ? e * f : f * e);
+                }
+                store(sum, r);
+            });
+        }
+
+        // Point cloud files of doubles, in place, each point rotated by its own rotation, on one thread.
+        // The throughput includes writing and reading the file.
+        quaternionCase("point_cloud", "file double", Output::Vector, true, [](const Inputs& in, double* out) {
+            std::filesystem::path path = std::filesystem::temp_directory_path() / ("quatbench_" + std::to_string(seedOf(in)));
+            try
+            {
+                std::FILE* f = std::fopen(path.string().c_str(), "wb");
+                if (!f || std::fwrite(in.v.data(), sizeof(double), in.v.size(), f) != in.v.size() || std::fclose(f) != 0)
+                {
+                    throw std::runtime_error("Cannot write " + path.string());
+                }
+                std::vector<Quaternion> q(in.n);
+                for (std::size_t i = 0; i < in.n; i++)
+                {
+                    q[i] = quaternion(in.a, i);
+                }
+                ensiie::PointCloudOptions options;
+                options.format = ensiie::PointFormat::Float64;
+                options.threads = 1;
+                ensiie::rotatePointGroups(path.string(), "", q.data(), in.n, 1, options);
+                f = std::fopen(path.string().c_str(), "rb");
+                std::size_t read = f ? std::fread(out, sizeof(double), 3 * in.n, f) : 0;
+                if (f)
+                {
+                    std::fclose(f);
+                }
+                if (read != 3 * in.n)
+                {
+                    throw std::runtime_error("Cannot read " + path.string());
+                }
+            }
+            catch (const std::exception&)
+            {
+                // Point clouds are not supported on every platform.
+                std::fill(out, out + 3 * in.n, std::numeric_limits<double>::quiet_NaN());
+            }
+            std::filesystem::remove(path);
+        }, refRotate);
+
+        // Template version, in single and double precision.
+        for (bool single : {false, true})
+        {
+            std::string impl = single ? "template float" : "template double";
+            quaternionCase("multiply", impl, Output::Quaternion, false, [single](const Inputs& in, double* out) {
+                bench::templateMultiply(single, in.a.data(), in.b.data(), out, in.n);
+            }, refMultiply);
+            quaternionCase("divide", impl, Output::Quaternion, false, [single](const Inputs& in, double* out) {
+                bench::templateDivide(single, in.a.data(), in.b.data(), out, in.n);
+            }, refDivide);
+            quaternionCase("inverse", impl, Output::Quaternion, false, [single](const Inputs& in, double* out) {
+                bench::templateInverse(single, in.a.data(), out, in.n);
+            }, refInverse);
+            quaternionCase("norm", impl, Output::Scalar, false, [single](const Inputs& in, double* out) {
+                bench::templateNorm(single, in.a.data(), out, in.n);
+            }, refNorm);
+        }
+        return c;
+    }
+
+    /**
+     * @brief Accuracy and speed of a case on a class of inputs.
+     *
+     */
+    struct Result
+    {
+        double maxUlp = 0, sumUlp = 0;
+        double maxAngle = 0, sumAngle = 0;
+        std::size_t compared = 0, failures = 0;
+        double throughput = 0;
+    };
+
+    /**
+     * @brief Largest errors accepted for a case on a class of inputs.
+     *
+     * Unchecked results have infinite bounds. The other ones fail on an error above the bounds, or on a failure
+     * unless the inputs may be rejected.
+     */
+    struct Bounds
+    {
+        double ulp;
+        double angle;
+        bool rejects = false;
+
+        bool checked() const { return std::isfinite(ulp) || std::isfinite(angle); }
+    };
+
+    /**
+     * @brief The bounds of a case on a class of inputs: about 4 times the largest errors seen with the default options,
+     * and the documented limits of the approximations and of the codecs.
+     *
+     */
+    Bounds bounds(const Case& c, const Inputs& in)
+    {
+        const double INF = std::numeric_limits<double>::infinity();
+        const std::string& op = c.operation;
+        const std::string& impl = c.implementation;
+        bool single = impl == "template float";
+        // Float overflows at 1e150.
+        if (single && in.name == "huge")
+        {
+            return Bounds{INF, INF};
+        }
+        if (op == "codec")
+        {
+            return Bounds{INF, impl == "32 bits" ? 4.2e-3 : (impl == "48 bits" ? 1.4e-4 : 4.3e-6)};
+        }
+        if (impl.find("fast") != std::string::npos)
+        {
+            // Absolute errors of 2e-9 on the trigonometric functions.
+            return Bounds{1e9, 1e-8, in.name == "tiny"};
+        }
+        if (single)
+        {
+            // 16 float ULPs, in double ULPs.
+            return Bounds{16 * std::ldexp(1.0, 29), INF, in.name == "tiny"};
+        }
+        const std::pair<const char*, double> ulps[] = {
+            {"multiply", 8}, {"divide", 16}, {"inverse", 16}, {"norm", 4}, {"normalize", 8}, {"rotate", 32},
+            {"to_matrix", 32}, {"from_matrix", 16}, {"exp", 16}, {"log", 64}, {"slerp", 16}, {"from_axis_angle", 8},
+            {"random_uniform", 24}, {"random_perturbed", 8}, {"gemm", 128}, {"point_cloud", 32}};
+        double ulp = op == "qft" ? (impl == "left 64" ? 160 : 1200) : INF;
+        for (const auto& [name, bound] : ulps)
+        {
+            if (op == name)
+            {
+                ulp = bound;
+            }
+        }
+        // Divisors, logarithms and axes of norm under 1e-15 are rejected by design.
+        return Bounds{ulp, 2e-15, in.name == "tiny"};
+    }
+
+    /**
+     * @brief A double ULP at the scale of x.
+     *
+     */
+    Real ulp(Real x)
+    {
+        if (x == 0 || !std::isfinite(static_cast<double>(x)))
+        {
+            return std::numeric_limits<double>::denorm_min();
+        }
+        return std::ldexp(Real(1), std::ilogb(static_cast<double>(x)) - 52);
+    }
+
+    Result evaluate(const Case& c, const Inputs& in, double minimum)
+    {
+        int w = width(c.output);
+        std::vector<double> out(w * in.n);
+        // The first run gives the results, the next ones the throughput.
+        c.run(in, out.data());
+        std::size_t runs = 0;
+        auto start = std::chrono::steady_clock::now();
+        double elapsed = 0;
+        std::vector<double> scratch(w * in.n);
+        do
+        {
+            c.run(in, scratch.data());
+            runs++;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < minimum);
+
+        Result r;
+        r.throughput = runs * in.n / elapsed / 1e6;
+        for (std::size_t i = 0; i < in.n; i++)
+        {
+            const double* x = &out[w * i];
+            Real ref[9];
+            c.reference(in, i, ref);
+            bool finite = true;
+            bool refFinite = true;
+            for (int k = 0; k < w; k++)
+            {
+                finite &= std::isfinite(x[k]);
+                refFinite &= std::isfinite(static_cast<double>(ref[k]));
+            }
+            if (!refFinite)
+            {
+                continue;
+            }
+            if (!finite)
+            {
+                r.failures++;
+                continue;
+            }
+            Real sign = 1;
+            if (c.output == Output::Rotation)
+            {
+                // q and -q are the same rotation.
+                Real d = 0;
+                for (int k = 0; k < 4; k++)
+                {
+                    d += x[k] * ref[k];
+                }
+                sign = d < 0 ? -1 : 1;
+            }
+            Real error = 0, scale = 0;
+            for (int k = 0; k < w; k++)
+            {
+                error = std::max(error, std::abs(x[k] - sign * ref[k]));
+                scale = std::max(scale, std::abs(ref[k]));
+            }
+            double ulps = static_cast<double>(error / ulp(scale));
+            r.maxUlp = std::max(r.maxUlp, ulps);
+            r.sumUlp += ulps;
+            if (c.output == Output::Rotation)
+            {
+                Ref p = normalize(load(x));
+                Ref q = normalize(Ref{ref[0], ref[1], ref[2], ref[3]}) * sign;
+                double angle = static_cast<double>(4 * std::atan2(norm(p + q * -1), norm(p + q)));
+                r.maxAngle = std::max(r.maxAngle, angle);
+                r.sumAngle += angle;
+            }
+            else if (c.output == Output::Vector)
+            {
+                Real cx = x[1] * ref[2] - x[2] * ref[1];
+                Real cy = x[2] * ref[0] - x[0] * ref[2];
+                Real cz = x[0] * ref[1] - x[1] * ref[0];
+                double angle = static_cast<double>(std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz),
+                                                              x[0] * ref[0] + x[1] * ref[1] + x[2] * ref[2]));
+                r.maxAngle = std::max(r.maxAngle, angle);
+                r.sumAngle += angle;
+            }
+            r.compared++;
+        }
+        return r;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        Options o = parseOptions(argc, argv);
+        if (std::numeric_limits<Real>::digits <= std::numeric_limits<double>::digits)
+        {
+            std::fprintf(stderr, "quatbench: warning: long double is not more precise than double on this platform\n");
+        }
+        const char* classes[] = {"random", "unit", "tiny", "huge", "antipodal", "close"};
+        std::vector<Inputs> inputs;
+        for (std::size_t k = 0; k < sizeof(classes) / sizeof(*classes); k++)
+        {
+            inputs.push_back(generate(classes[k], o.n, o.seed + k));
+        }
+        std::printf("%-16s %-18s %-10s %12s %12s %12s %12s %9s %9s %10s %6s\n", "operation", "implementation", "inputs",
+                    "max ulp", "mean ulp", "max angle", "mean angle", "failures", "compared", "Mop/s", "check");
+        std::size_t exceeded = 0;
+        for (const Case& c : cases())
+        {
+            if (!o.filter.empty() && (c.operation + " " + c.implementation).find(o.filter) == std::string::npos)
+            {
+                continue;
+            }
+            for (const Inputs& in : inputs)
+            {
+                if (c.unitOnly && !in.unit)
+                {
+                    continue;
+                }
+                Result r = evaluate(c, in, o.time);
+                bool angular = c.output == Output::Rotation || c.output == Output::Vector;
+                double mean = r.compared ? r.sumUlp / r.compared : 0;
+                std::printf("%-16s %-18s %-10s %12.4g %12.4g ", c.operation.c_str(), c.implementation.c_str(),
+                            in.name.c_str(), r.maxUlp, mean);
+                if (angular)
+                {
+                    std::printf("%12.3e %12.3e ", r.maxAngle, r.compared ? r.sumAngle / r.compared : 0);
+                }
+                else
+                {
+                    std::printf("%12s %12s ", "-", "-");
+                }
+                std::printf("%9zu %9zu %10.1f ", r.failures, r.compared, r.throughput);
+                Bounds b = bounds(c, in);
+                if (!b.checked())
+                {
+                    std::printf("%6s\n", "-");
+                }
+                else if ((r.failures > 0 && !b.rejects) || r.maxUlp > b.ulp || (angular && r.maxAngle > b.angle))
+                {
+                    std::printf("%6s\n", "FAIL");
+                    exceeded++;
+                }
+                else
+                {
+                    std::printf("%6s\n", "ok");
+                }
+            }
+        }
+        if (exceeded > 0)
+        {
+            std::fprintf(stderr, "quatbench: %zu results exceed their bounds\n", exceeded);
+            return 1;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "quatbench: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
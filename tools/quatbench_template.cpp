@@ -0,0 +1,102 @@
+/**
+ * @file quatbench_template.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Implements {@link quatbench_template.h}.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+
+#include "quatbench_template.h"
+#include <limits>
+#include <stdexcept>
+
+// The template version is defined in its source file and warns about its own code.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wreorder"
+#pragma GCC diagnostic ignored "-Wnon-template-friend"
+#include "quaternion_template.cpp"
+#pragma GCC diagnostic pop
+
+namespace
+{
+    template <typename T>
+    ensiie::Quaternion<T> load(const double* p)
+    {
+        return ensiie::Quaternion<T>(static_cast<T>(p[0]), static_cast<T>(p[1]), static_cast<T>(p[2]), static_cast<T>(p[3]));
+    }
+
+    template <typename T>
+    void store(double* p, const ensiie::Quaternion<T>& q)
+    {
+        p[0] = q.getT();
+        p[1] = q.getU();
+        p[2] = q.getV();
+        p[3] = q.getW();
+    }
+
+    template <typename T, typename Operation>
+    void run(const double* a, const double* b, double* out, std::size_t n, int width, Operation operation)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            try
+            {
+                operation(a + 4 * i, b ? b + 4 * i : nullptr, out + width * i);
+            }
+            catch (const std::exception&)
+            {
+                for (int k = 0; k < width; k++)
+                {
+                    out[width * i + k] = std::numeric_limits<double>::quiet_NaN();
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    void multiply(const double* a, const double* b, double* out, std::size_t n)
+    {
+        run<T>(a, b, out, n, 4, [](const double* x, const double* y, double* o) { store(o, load<T>(x) * load<T>(y)); });
+    }
+
+    template <typename T>
+    void divide(const double* a, const double* b, double* out, std::size_t n)
+    {
+        run<T>(a, b, out, n, 4, [](const double* x, const double* y, double* o) { store(o, load<T>(x) / load<T>(y)); });
+    }
+
+    template <typename T>
+    void inverse(const double* a, double* out, std::size_t n)
+    {
+        run<T>(a, nullptr, out, n, 4, [](const double* x, const double*, double* o) { store(o, load<T>(x).inverse()); });
+    }
+
+    template <typename T>
+    void norm(const double* a, double* out, std::size_t n)
+    {
+        run<T>(a, nullptr, out, n, 1, [](const double* x, const double*, double* o) { *o = load<T>(x).norm(); });
+    }
+}
+
+void bench::templateMultiply(bool single, const double* a, const double* b, double* out, std::size_t n)
+{
+    single ? multiply<float>(a, b, out, n) : multiply<double>(a, b, out, n);
+}
+
+void bench::templateDivide(bool single, const double* a, const double* b, double* out, std::size_t n)
+{
+    single ? divide<float>(a, b, out, n) : divide<double>(a, b, out, n);
+}
+
+void bench::templateInverse(bool single, const double* a, double* out, std::size_t n)
+{
+    single ? inverse<float>(a, out, n) : inverse<double>(a, out, n);
+}
+
+void bench::templateNorm(bool single, const double* a, double* out, std::size_t n)
+{
+    single ? norm<float>(a, out, n) : norm<double>(a, out, n);
+}
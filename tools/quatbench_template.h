@@ -0,0 +1,48 @@
+/**
+ * @file quatbench_template.h
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Runs the operations of the template version for quatbench.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * The template version declares ensiie::Quaternion as a class template, which cannot share a translation unit with
+ * the class of the double version: it is compiled apart and only exchanges arrays of doubles (t, u, v, w).
+ * A failed operation writes NaN.
+ *
+ */
+
+#ifndef QUATBENCH_TEMPLATE_H
+#define QUATBENCH_TEMPLATE_H
+
+#include <cstddef>
+
+namespace bench
+{
+    /**
+     * @brief out = a * b with Quaternion<float> (single) or Quaternion<double>.
+     *
+     */
+    void templateMultiply(bool single, const double* a, const double* b, double* out, std::size_t n);
+
+    /**
+     * @brief out = a / b.
+     *
+     */
+    void templateDivide(bool single, const double* a, const double* b, double* out, std::size_t n);
+
+    /**
+     * @brief out = a.inverse().
+     *
+     */
+    void templateInverse(bool single, const double* a, double* out, std::size_t n);
+
+    /**
+     * @brief out = a.norm(), one double per quaternion.
+     *
+     */
+    void templateNorm(bool single, const double* a, double* out, std::size_t n);
+}
+
+#endif // QUATBENCH_TEMPLATE_H
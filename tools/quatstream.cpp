@@ -0,0 +1,533 @@
+/**
+ * @file quatstream.cpp
+ * @author Thomas Roiseux (thomas.roiseux@outlook.com)
+ * @brief Streams quaternions from a file through a pipeline of operations.
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2022
+ *
+ * The input is read in fixed-size chunks. A reader thread, the computing thread and a writer thread
+ * exchange a fixed pool of chunks, so that reading, computing and writing overlap and memory stays
+ * bounded whatever the size of the input.
+ *
+ * Text streams hold one quaternion per line, as 4 numbers separated by spaces or commas, lines starting
+ * with # being ignored. Binary streams hold 4 native doubles per quaternion. The components are in the
+ * order t, u, v, w, or u, v, w, t with the xyzw layout; --in and --out, and --in-layout and --out-layout,
+ * convert between formats and layouts.
+ *
+ */
+
+#include "quaternion.h"
+#include "quaternion_c.h"
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace
+{
+    /**
+     * @brief A chunk of quaternions, in the input layout until the operations, then in the output layout.
+     *
+     */
+    struct Chunk
+    {
+        std::vector<double> data;
+        std::size_t count = 0;
+    };
+
+    /**
+     * @brief A blocking queue between two threads.
+     *
+     */
+    class Channel
+    {
+    private:
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<Chunk*> items;
+        bool closed = false;
+
+    public:
+        void push(Chunk* c)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                items.push_back(c);
+            }
+            cv.notify_one();
+        }
+
+        /**
+         * @brief Waits for a chunk.
+         *
+         * @return Chunk* The chunk, or nullptr once the channel is closed and empty.
+         */
+        Chunk* pop()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] { return !items.empty() || closed; });
+            if (items.empty())
+            {
+                return nullptr;
+            }
+            Chunk* c = items.front();
+            items.pop_front();
+            return c;
+        }
+
+        void close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                closed = true;
+            }
+            cv.notify_all();
+        }
+    };
+
+    /**
+     * @brief An operation of the pipeline.
+     *
+     */
+    struct Operation
+    {
+        enum Kind
+        {
+            Left,
+            Right,
+            Normalize,
+            Conjugate
+        } kind;
+        double q[4];
+    };
+
+    struct Options
+    {
+        std::string input = "-";
+        std::string output = "-";
+        bool binaryIn = false;
+        bool binaryOut = false;
+        int layoutIn = QUAT_LAYOUT_WXYZ;
+        int layoutOut = QUAT_LAYOUT_WXYZ;
+        std::size_t chunk = 16384;
+        std::size_t buffers = 4;
+        std::vector<Operation> operations;
+    };
+
+    void usage()
+    {
+        std::fprintf(stderr,
+                     "Usage: quatstream [options] [operations]\n"
+                     "Options:\n"
+                     "  -i FILE           Input file, - for stdin (default).\n"
+                     "  -o FILE           Output file, - for stdout (default).\n"
+                     "  --in text|binary  Input format (default text).\n"
+                     "  --out text|binary Output format (default text).\n"
+                     "  --in-layout wxyz|xyzw\n"
+                     "                    Order of the input components, real part first (default) or last.\n"
+                     "  --out-layout wxyz|xyzw\n"
+                     "                    Order of the output components (default wxyz).\n"
+                     "  --chunk N         Quaternions per chunk (default 16384).\n"
+                     "  --buffers N       Chunks in flight, at least 3 (default 4).\n"
+                     "Operations, applied in order, whatever the layouts:\n"
+                     "  left:t,u,v,w      q <- r * q.\n"
+                     "  right:t,u,v,w     q <- q * r.\n"
+                     "  normalize         q <- q / |q|.\n"
+                     "  conjugate         q <- conjugate(q).\n");
+    }
+
+    bool parseFormat(const std::string& s)
+    {
+        if (s == "text")
+        {
+            return false;
+        }
+        if (s == "binary")
+        {
+            return true;
+        }
+        throw std::invalid_argument("Unknown format: " + s);
+    }
+
+    int parseLayout(const std::string& s)
+    {
+        if (s == "wxyz")
+        {
+            return QUAT_LAYOUT_WXYZ;
+        }
+        if (s == "xyzw")
+        {
+            return QUAT_LAYOUT_XYZW;
+        }
+        throw std::invalid_argument("Unknown layout: " + s);
+    }
+
+    Operation parseOperation(const std::string& s)
+    {
+        Operation op{};
+        if (s == "normalize")
+        {
+            op.kind = Operation::Normalize;
+            return op;
+        }
+        if (s == "conjugate")
+        {
+            op.kind = Operation::Conjugate;
+            return op;
+        }
+        std::size_t colon = s.find(':');
+        std::string name = s.substr(0, colon);
+        if (colon == std::string::npos || (name != "left" && name != "right"))
+        {
+            throw std::invalid_argument("Unknown operation: " + s);
+        }
+        op.kind = name == "left" ? Operation::Left : Operation::Right;
+        const char* p = s.c_str() + colon + 1;
+        for (int i = 0; i < 4; i++)
+        {
+            char* end;
+            op.q[i] = std::strtod(p, &end);
+            if (end == p || *end != (i < 3 ? ',' : '\0'))
+            {
+                throw std::invalid_argument("Expected 4 comma-separated numbers: " + s);
+            }
+            p = end + 1;
+        }
+        return op;
+    }
+
+    Options parseOptions(int argc, char** argv)
+    {
+        Options o;
+        for (int i = 1; i < argc; i++)
+        {
+            std::string a = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (a == "-h" || a == "--help")
+            {
+                usage();
+                std::exit(0);
+            }
+            else if (a == "-i" && hasValue)
+            {
+                o.input = argv[++i];
+            }
+            else if (a == "-o" && hasValue)
+            {
+                o.output = argv[++i];
+            }
+            else if (a == "--in" && hasValue)
+            {
+                o.binaryIn = parseFormat(argv[++i]);
+            }
+            else if (a == "--out" && hasValue)
+            {
+                o.binaryOut = parseFormat(argv[++i]);
+            }
+            else if (a == "--in-layout" && hasValue)
+            {
+                o.layoutIn = parseLayout(argv[++i]);
+            }
+            else if (a == "--out-layout" && hasValue)
+            {
+                o.layoutOut = parseLayout(argv[++i]);
+            }
+            else if (a == "--chunk" && hasValue)
+            {
+                o.chunk = std::strtoul(argv[++i], nullptr, 10);
+            }
+            else if (a == "--buffers" && hasValue)
+            {
+                o.buffers = std::strtoul(argv[++i], nullptr, 10);
+            }
+            else
+            {
+                o.operations.push_back(parseOperation(a));
+            }
+        }
+        if (o.chunk == 0 || o.buffers < 3)
+        {
+            throw std::invalid_argument("The chunk size must be positive and there must be at least 3 buffers");
+        }
+        return o;
+    }
+
+    /**
+     * @brief Longest text line, without its end of line.
+     *
+     */
+    constexpr std::size_t MAX_LINE = 1023;
+
+    /**
+     * @brief Reads up to one chunk of quaternions.
+     *
+     * @return std::size_t Number of quaternions read, 0 at the end of the input.
+     */
+    std::size_t readChunk(std::FILE* f, bool binary, Chunk& c, std::size_t capacity, std::size_t& line)
+    {
+        constexpr std::size_t record = 4 * sizeof(double);
+        if (binary)
+        {
+            // Bytes rather than doubles are counted, so that a partial double at the end is not lost silently.
+            std::size_t n = std::fread(c.data.data(), 1, record * capacity, f);
+            if (std::ferror(f))
+            {
+                throw std::runtime_error("Read error");
+            }
+            if (n % record != 0)
+            {
+                throw std::runtime_error("Truncated binary input: " + std::to_string(n % record) +
+                                         " trailing bytes after the last quaternion");
+            }
+            return n / record;
+        }
+        // The longest line, its end of line (CR LF at most) and the terminating null character.
+        char buffer[MAX_LINE + 3];
+        std::size_t n = 0;
+        while (n < capacity && std::fgets(buffer, sizeof(buffer), f))
+        {
+            line++;
+            std::size_t length = std::strlen(buffer);
+            bool complete = length > 0 && buffer[length - 1] == '\n';
+            // The end of line, LF or CR LF, does not count in MAX_LINE.
+            length -= complete ? 1 : 0;
+            length -= complete && length > 0 && buffer[length - 1] == '\r' ? 1 : 0;
+            if ((!complete && !std::feof(f)) || length > MAX_LINE)
+            {
+                throw std::runtime_error("Line " + std::to_string(line) + ": longer than " +
+                                         std::to_string(MAX_LINE) + " characters");
+            }
+            const char* p = buffer;
+            while (*p == ' ' || *p == '\t')
+            {
+                p++;
+            }
+            if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0')
+            {
+                continue;
+            }
+            double* q = c.data.data() + 4 * n;
+            for (int i = 0; i < 4; i++)
+            {
+                char* end;
+                q[i] = std::strtod(p, &end);
+                if (end == p)
+                {
+                    throw std::runtime_error("Line " + std::to_string(line) + ": expected 4 numbers");
+                }
+                p = end;
+                while (*p == ' ' || *p == '\t' || *p == ',')
+                {
+                    p++;
+                }
+            }
+            if (*p != '\n' && *p != '\r' && *p != '\0')
+            {
+                throw std::runtime_error("Line " + std::to_string(line) + ": expected 4 numbers, got more");
+            }
+            n++;
+        }
+        if (std::ferror(f))
+        {
+            throw std::runtime_error("Read error");
+        }
+        return n;
+    }
+
+    void writeChunk(std::FILE* f, bool binary, const Chunk& c)
+    {
+        if (binary)
+        {
+            if (std::fwrite(c.data.data(), sizeof(double), 4 * c.count, f) != 4 * c.count)
+            {
+                throw std::runtime_error("Write error");
+            }
+            return;
+        }
+        char buffer[128];
+        for (std::size_t i = 0; i < c.count; i++)
+        {
+            const double* q = c.data.data() + 4 * i;
+            int n = std::snprintf(buffer, sizeof(buffer), "%.17g %.17g %.17g %.17g\n", q[0], q[1], q[2], q[3]);
+            if (std::fwrite(buffer, 1, n, f) != static_cast<std::size_t>(n))
+            {
+                throw std::runtime_error("Write error");
+            }
+        }
+    }
+
+    void apply(const Options& o, Chunk& c)
+    {
+        double* q = c.data.data();
+        // The operations work on t, u, v, w.
+        quat_convert_layout(c.count, q, 4, o.layoutIn, q, 4, QUAT_LAYOUT_WXYZ);
+        for (const Operation& op : o.operations)
+        {
+            switch (op.kind)
+            {
+            case Operation::Left:
+                quat_multiply(c.count, op.q, 0, q, 4, q, 4, QUAT_LAYOUT_WXYZ);
+                break;
+            case Operation::Right:
+                quat_multiply(c.count, q, 4, op.q, 0, q, 4, QUAT_LAYOUT_WXYZ);
+                break;
+            case Operation::Normalize:
+                // Null quaternions are left unchanged.
+                quat_normalize(c.count, q, 4, q, 4, QUAT_LAYOUT_WXYZ);
+                break;
+            case Operation::Conjugate:
+                for (std::size_t i = 0; i < c.count; i++)
+                {
+                    q[4 * i + 1] = -q[4 * i + 1];
+                    q[4 * i + 2] = -q[4 * i + 2];
+                    q[4 * i + 3] = -q[4 * i + 3];
+                }
+                break;
+            }
+        }
+        quat_convert_layout(c.count, q, 4, QUAT_LAYOUT_WXYZ, q, 4, o.layoutOut);
+    }
+
+    std::FILE* open(const std::string& path, const char* mode, std::FILE* standard)
+    {
+        if (path == "-")
+        {
+            return standard;
+        }
+        std::FILE* f = std::fopen(path.c_str(), mode);
+        if (!f)
+        {
+            throw std::runtime_error("Cannot open " + path);
+        }
+        return f;
+    }
+
+    void run(const Options& o)
+    {
+        std::FILE* in = open(o.input, o.binaryIn ? "rb" : "r", stdin);
+        std::FILE* out = open(o.output, o.binaryOut ? "wb" : "w", stdout);
+#ifdef _WIN32
+        if (in == stdin && o.binaryIn)
+        {
+            _setmode(_fileno(stdin), _O_BINARY);
+        }
+        if (out == stdout && o.binaryOut)
+        {
+            _setmode(_fileno(stdout), _O_BINARY);
+        }
+#endif
+
+        std::vector<Chunk> pool(o.buffers);
+        Channel free, filled, done;
+        for (Chunk& c : pool)
+        {
+            c.data.resize(4 * o.chunk);
+            free.push(&c);
+        }
+
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        auto fail = [&](std::exception_ptr e) {
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error)
+                {
+                    error = e;
+                }
+            }
+            free.close();
+            filled.close();
+            done.close();
+        };
+
+        std::thread reader([&] {
+            try
+            {
+                std::size_t line = 0;
+                while (Chunk* c = free.pop())
+                {
+                    c->count = readChunk(in, o.binaryIn, *c, o.chunk, line);
+                    if (c->count == 0)
+                    {
+                        break;
+                    }
+                    filled.push(c);
+                }
+                filled.close();
+            }
+            catch (...)
+            {
+                fail(std::current_exception());
+            }
+        });
+
+        std::thread writer([&] {
+            try
+            {
+                while (Chunk* c = done.pop())
+                {
+                    writeChunk(out, o.binaryOut, *c);
+                    free.push(c);
+                }
+                if (std::fflush(out) != 0)
+                {
+                    throw std::runtime_error("Write error");
+                }
+            }
+            catch (...)
+            {
+                fail(std::current_exception());
+            }
+        });
+
+        while (Chunk* c = filled.pop())
+        {
+            apply(o, *c);
+            done.push(c);
+        }
+        done.close();
+
+        reader.join();
+        writer.join();
+        if (in != stdin)
+        {
+            std::fclose(in);
+        }
+        if (out != stdout && std::fclose(out) != 0 && !error)
+        {
+            throw std::runtime_error("Write error");
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        run(parseOptions(argc, argv));
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "quatstream: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}